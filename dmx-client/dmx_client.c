@@ -4,10 +4,14 @@
  *
  * DMX Client - RPMSG bridge utility for Linux.
  *
+ * Thin CLI over libdmx (libdmx.h) - all protocol logic lives in the
+ * library so other processes can link it directly.
+ *
  * Usage:
  *   ./dmx_client enable                    # Human-friendly output
  *   ./dmx_client enable --json             # JSON output for scripts
  *   ./dmx_client enable --quiet            # Minimal output (exit code only)
+ *   ./dmx_client --daemon                  # Persistent daemon (Unix socket)
  *
  */
 
@@ -16,24 +20,30 @@
 #include <stdint.h>
 #include <string.h>
 #include <unistd.h>
-#include <fcntl.h>
 #include <time.h>
 #include <errno.h>
 #include <stdbool.h>
-#include <sys/select.h>
-#include <termios.h>
-#include "dmx_protocol.h"
+#include <signal.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include "libdmx.h"
 
 /* ============================================================================
  * Configuration
  * ============================================================================ */
 
 #define DEFAULT_DEV     "/dev/ttyRPMSG0"
-#define TIMEOUT_MS      1000            /* Response timeout */
+#define DEFAULT_SOCKET  "/run/dmx.sock" /* Daemon command socket */
 
 /* Device path (can be overridden with --device) */
 static const char *g_device = DEFAULT_DEV;
 
+/* Daemon socket path (can be overridden with --socket) */
+static const char *g_socket_path = DEFAULT_SOCKET;
+
 /* Output formats */
 typedef enum {
     OUTPUT_HUMAN,   /* Human-friendly (colors, emojis) */
@@ -44,6 +54,22 @@ typedef enum {
 /* Global output format */
 static OutputFormat g_output_format = OUTPUT_HUMAN;
 
+/* Fire-and-forget mode for write commands (--no-ack) */
+static bool g_no_ack = false;
+
+/* Raw rpmsg_char transport instead of the tty (--transport rpmsg-raw) */
+static bool g_raw_transport = false;
+
+/* Shared-memory universe mirror (--shm): bulk channel data bypasses RPMSG */
+static bool g_use_shm = false;
+static dmx_shm_t *g_shm = NULL;
+
+/* Target universe (-u/--universe); 0 = default output, v1 framing */
+static int g_universe = 0;
+
+/* Watch mode push period (--interval, ms) */
+static int g_watch_interval_ms = 1000;
+
 /* ============================================================================
  * Helper Functions
  * ============================================================================ */
@@ -59,279 +85,410 @@ static uint64_t get_time_us(void)
 }
 
 /*
- * Wait for data with timeout using select()
- * Returns: 1 if data available, 0 on timeout, -1 on error
+ * Report a libdmx error in the current output format
  */
-static int wait_for_data(int fd, int timeout_ms)
+static void report_cmd_error(int err)
 {
-    fd_set read_fds;
-    struct timeval tv;
-
-    FD_ZERO(&read_fds);
-    FD_SET(fd, &read_fds);
-
-    tv.tv_sec = timeout_ms / 1000;
-    tv.tv_usec = (timeout_ms % 1000) * 1000;
-
-    return select(fd + 1, &read_fds, NULL, NULL, &tv);
+    if (g_output_format == OUTPUT_JSON) {
+        printf("{\"status\":\"error\",\"error\":\"%s\"}\n", dmx_error_string(err));
+    } else if (g_output_format != OUTPUT_QUIET) {
+        fprintf(stderr, "Error: %s\n", dmx_error_string(err));
+    }
 }
 
+/* ============================================================================
+ * Command Wrappers (libdmx call + output formatting)
+ * ============================================================================ */
+
 /*
- * Configure TTY for raw binary mode
- * Essential for binary protocols - prevents control char interpretation
+ * Enable DMX transmission
  */
-static int configure_tty_raw(int fd)
+static int dmx_enable(dmx_conn_t *conn)
 {
-    struct termios tty;
-    if (tcgetattr(fd, &tty) < 0) return -1;
-
-    cfmakeraw(&tty);
+    uint64_t t0 = get_time_us();
+    int ret = dmx_cmd_enable(conn);
+    uint64_t t1 = get_time_us();
+    unsigned long latency = (unsigned long)(t1 - t0);
 
-    /* VMIN=1: read() blocks until at least 1 byte available */
-    tty.c_cc[VMIN] = 1;
-    tty.c_cc[VTIME] = 0;
+    if (ret == DMX_OK) {
+        switch (g_output_format) {
+            case OUTPUT_JSON:
+                printf("{\"status\":\"ok\",\"command\":\"enable\",\"latency_us\":%lu}\n", latency);
+                break;
+            case OUTPUT_QUIET:
+                /* Silent success */
+                break;
+            case OUTPUT_HUMAN:
+            default:
+                printf("✅ DMX enabled (latency: %lu µs)\n", latency);
+                break;
+        }
+    } else {
+        report_cmd_error(ret);
+    }
 
-    if (tcsetattr(fd, TCSANOW, &tty) < 0) return -1;
-    return 0;
+    return ret;
 }
 
 /*
- * Read exactly 'count' bytes via polling loop
- * Returns: number of bytes read (should equal count), or -1 on error/timeout
+ * Disable DMX transmission
  */
-static int read_exact(int fd, uint8_t *buf, int count, int timeout_ms)
+static int dmx_disable(dmx_conn_t *conn)
 {
-    int total_read = 0;
-    while (total_read < count) {
-        int sel_ret = wait_for_data(fd, timeout_ms);
-        if (sel_ret <= 0) return -1;  /* Timeout or error */
-
-        int n = read(fd, buf + total_read, count - total_read);
-        if (n < 0) return -1;
-        if (n == 0) return total_read;  /* Unexpected EOF */
+    uint64_t t0 = get_time_us();
+    int ret = dmx_cmd_disable(conn);
+    uint64_t t1 = get_time_us();
+    unsigned long latency = (unsigned long)(t1 - t0);
 
-        total_read += n;
+    if (ret == DMX_OK) {
+        switch (g_output_format) {
+            case OUTPUT_JSON:
+                printf("{\"status\":\"ok\",\"command\":\"disable\",\"latency_us\":%lu}\n", latency);
+                break;
+            case OUTPUT_QUIET:
+                /* Silent success */
+                break;
+            case OUTPUT_HUMAN:
+            default:
+                printf("✅ DMX disabled (latency: %lu µs)\n", latency);
+                break;
+        }
+    } else {
+        report_cmd_error(ret);
     }
-    return total_read;
+
+    return ret;
 }
 
 /*
- * Build command packet
- *
- * Returns: total packet size
+ * Set DMX channels
  */
-static int build_cmd_packet(uint8_t *buf, uint8_t cmd, const uint8_t *payload, uint16_t payload_len)
+static int dmx_set_channels(dmx_conn_t *conn, uint16_t start_channel, const uint8_t *values, uint16_t count)
 {
-    buf[0] = DMX_MAGIC_CMD;
-    buf[1] = cmd;
-    buf[2] = payload_len & 0xFF;         /* Little-endian length */
-    buf[3] = (payload_len >> 8) & 0xFF;
+    uint64_t t0 = get_time_us();
+    int ret = g_shm ? dmx_shm_publish(g_shm, start_channel, values, count)
+                    : dmx_cmd_set_channels(conn, start_channel, values, count);
+    uint64_t t1 = get_time_us();
+    unsigned long latency = (unsigned long)(t1 - t0);
 
-    if (payload_len > 0) {
-        memcpy(&buf[4], payload, payload_len);
+    if (ret == DMX_OK) {
+        switch (g_output_format) {
+            case OUTPUT_JSON:
+                printf("{\"status\":\"ok\",\"command\":\"set\",\"start_channel\":%d,\"count\":%d,\"latency_us\":%lu}\n",
+                       start_channel, count, latency);
+                break;
+            case OUTPUT_QUIET:
+                /* Silent success */
+                break;
+            case OUTPUT_HUMAN:
+            default:
+                printf("✅ Channels %d-%d set (latency: %lu µs)\n",
+                       start_channel, start_channel + count - 1, latency);
+                break;
+        }
+    } else {
+        report_cmd_error(ret);
     }
 
-    /* Calculate checksum (entire packet except checksum byte) */
-    uint8_t checksum = dmx_calc_checksum(buf, 4 + payload_len);
-    buf[4 + payload_len] = checksum;
-
-    return 4 + payload_len + 1;  /* header + payload + checksum */
+    return ret;
 }
 
 /*
- * Send command and receive response
- *
- * Returns: 0 on success, -1 on error
+ * Set non-contiguous DMX channels
  */
-static int send_cmd_and_recv(int fd, uint8_t cmd, const uint8_t *payload, uint16_t payload_len,
-                             uint8_t *resp_buf, uint16_t resp_buf_size, uint16_t *resp_len)
+static int dmx_set_sparse(dmx_conn_t *conn, const uint16_t *channels, const uint8_t *values, uint16_t count)
 {
-    uint8_t tx_buf[DMX_MAX_PAYLOAD];
-    int tx_len = build_cmd_packet(tx_buf, cmd, payload, payload_len);
+    uint64_t t0 = get_time_us();
+    int ret = dmx_cmd_set_sparse(conn, channels, values, count);
+    uint64_t t1 = get_time_us();
+    unsigned long latency = (unsigned long)(t1 - t0);
 
-    /* Send command */
-    if (write(fd, tx_buf, tx_len) != tx_len) {
-        if (g_output_format != OUTPUT_QUIET) {
-            fprintf(stderr, "Error: write failed: %s\n", strerror(errno));
+    if (ret == DMX_OK) {
+        switch (g_output_format) {
+            case OUTPUT_JSON:
+                printf("{\"status\":\"ok\",\"command\":\"sparse\",\"count\":%d,\"latency_us\":%lu}\n",
+                       count, latency);
+                break;
+            case OUTPUT_QUIET:
+                /* Silent success */
+                break;
+            case OUTPUT_HUMAN:
+            default:
+                printf("✅ %d channels set (sparse, latency: %lu µs)\n", count, latency);
+                break;
         }
-        return -1;
+    } else {
+        report_cmd_error(ret);
     }
 
-    /* Read response header (4 bytes) with timeout */
-    uint8_t hdr[4];
-    int n = read_exact(fd, hdr, 4, TIMEOUT_MS);
-    if (n < 4) {
-        if (g_output_format == OUTPUT_JSON) {
-            printf("{\"status\":\"error\",\"error\":\"Timeout waiting for response\"}\n");
-        } else if (g_output_format != OUTPUT_QUIET) {
-            fprintf(stderr, "Error: Timeout or incomplete header (got %d bytes)\n", n < 0 ? 0 : n);
-        }
-        return -1;
-    }
+    return ret;
+}
 
-    /* Verify magic */
-    if (hdr[0] != DMX_MAGIC_RESP) {
-        if (g_output_format != OUTPUT_QUIET) {
-            fprintf(stderr, "Error: Invalid response magic 0x%02x (expected 0x%02x)\n",
-                    hdr[0], DMX_MAGIC_RESP);
+/*
+ * Stage DMX channels into the firmware's pending buffer
+ */
+static int dmx_stage(dmx_conn_t *conn, uint16_t start_channel, const uint8_t *values, uint16_t count)
+{
+    uint64_t t0 = get_time_us();
+    int ret = dmx_cmd_stage(conn, start_channel, values, count);
+    uint64_t t1 = get_time_us();
+    unsigned long latency = (unsigned long)(t1 - t0);
+
+    if (ret == DMX_OK) {
+        switch (g_output_format) {
+            case OUTPUT_JSON:
+                printf("{\"status\":\"ok\",\"command\":\"stage\",\"start_channel\":%d,\"count\":%d,\"latency_us\":%lu}\n",
+                       start_channel, count, latency);
+                break;
+            case OUTPUT_QUIET:
+                /* Silent success */
+                break;
+            case OUTPUT_HUMAN:
+            default:
+                printf("✅ Channels %d-%d staged (commit to apply, latency: %lu µs)\n",
+                       start_channel, start_channel + count - 1, latency);
+                break;
         }
-        return -1;
+    } else {
+        report_cmd_error(ret);
     }
 
-    uint8_t status = hdr[1];
-    uint16_t data_len = hdr[2] | (hdr[3] << 8);
+    return ret;
+}
 
-    /* Read payload if any */
-    if (data_len > 0) {
-        if (data_len > resp_buf_size) {
-            if (g_output_format != OUTPUT_QUIET) {
-                fprintf(stderr, "Error: Response data too large (%d > %d)\n", data_len, resp_buf_size);
-            }
-            return -1;
-        }
-        n = read_exact(fd, resp_buf, data_len, TIMEOUT_MS);
-        if (n != data_len) {
-            if (g_output_format != OUTPUT_QUIET) {
-                fprintf(stderr, "Error: Incomplete payload (got %d, expected %d)\n", n < 0 ? 0 : n, data_len);
-            }
-            return -1;
-        }
-    }
+/*
+ * Commit staged channels at the next frame boundary
+ */
+static int dmx_commit(dmx_conn_t *conn)
+{
+    uint64_t t0 = get_time_us();
+    int ret = dmx_cmd_commit(conn);
+    uint64_t t1 = get_time_us();
+    unsigned long latency = (unsigned long)(t1 - t0);
 
-    /* Read checksum */
-    uint8_t checksum;
-    if (read_exact(fd, &checksum, 1, TIMEOUT_MS) != 1) {
-        if (g_output_format != OUTPUT_QUIET) {
-            fprintf(stderr, "Error: Failed to read checksum\n");
+    if (ret == DMX_OK) {
+        switch (g_output_format) {
+            case OUTPUT_JSON:
+                printf("{\"status\":\"ok\",\"command\":\"commit\",\"latency_us\":%lu}\n", latency);
+                break;
+            case OUTPUT_QUIET:
+                /* Silent success */
+                break;
+            case OUTPUT_HUMAN:
+            default:
+                printf("✅ Staged channels committed (latency: %lu µs)\n", latency);
+                break;
         }
-        return -1;
+    } else {
+        report_cmd_error(ret);
     }
 
-    /* Verify checksum */
-    uint8_t full_packet[4 + data_len + 1];
-    memcpy(full_packet, hdr, 4);
-    if (data_len > 0) memcpy(&full_packet[4], resp_buf, data_len);
-    full_packet[4 + data_len] = checksum;
+    return ret;
+}
 
-    if (!dmx_verify_checksum(full_packet, 4 + data_len + 1)) {
-        if (g_output_format != OUTPUT_QUIET) {
-            fprintf(stderr, "Error: Invalid checksum\n");
-        }
-        return -1;
-    }
+/*
+ * Fade DMX channels to target values (firmware-side interpolation)
+ */
+static int dmx_fade(dmx_conn_t *conn, uint16_t start_channel, const uint8_t *targets,
+                    uint16_t count, uint16_t duration_ms, uint8_t easing)
+{
+    uint64_t t0 = get_time_us();
+    int ret = dmx_cmd_fade(conn, start_channel, targets, count, duration_ms, easing);
+    uint64_t t1 = get_time_us();
+    unsigned long latency = (unsigned long)(t1 - t0);
 
-    /* Check status */
-    if (status != STATUS_OK) {
-        if (g_output_format != OUTPUT_QUIET) {
-            fprintf(stderr, "Error: Command failed with status 0x%02x\n", status);
+    if (ret == DMX_OK) {
+        switch (g_output_format) {
+            case OUTPUT_JSON:
+                printf("{\"status\":\"ok\",\"command\":\"fade\",\"start_channel\":%d,\"count\":%d,\"duration_ms\":%d,\"latency_us\":%lu}\n",
+                       start_channel, count, duration_ms, latency);
+                break;
+            case OUTPUT_QUIET:
+                /* Silent success */
+                break;
+            case OUTPUT_HUMAN:
+            default:
+                printf("✅ Fading channels %d-%d over %d ms (latency: %lu µs)\n",
+                       start_channel, start_channel + count - 1, duration_ms, latency);
+                break;
         }
-        return -1;
+    } else {
+        report_cmd_error(ret);
     }
 
-    *resp_len = data_len;
-    return 0;
+    return ret;
 }
 
-/* ============================================================================
- * API Functions
- * ============================================================================ */
-
 /*
- * Enable DMX transmission
+ * Configure adaptive refresh (keep-alive throttling while static)
  */
-static int dmx_enable(int fd)
+static int dmx_set_adaptive_mode(dmx_conn_t *conn, uint16_t keepalive_hz,
+                                 uint16_t idle_frames)
 {
-    uint8_t resp_buf[16];
-    uint16_t resp_len;
-
     uint64_t t0 = get_time_us();
-    int ret = send_cmd_and_recv(fd, CMD_DMX_ENABLE, NULL, 0, resp_buf, sizeof(resp_buf), &resp_len);
+    int ret = dmx_cmd_set_adaptive(conn, keepalive_hz, idle_frames);
     uint64_t t1 = get_time_us();
     unsigned long latency = (unsigned long)(t1 - t0);
 
-    if (ret == 0) {
+    if (ret == DMX_OK) {
         switch (g_output_format) {
             case OUTPUT_JSON:
-                printf("{\"status\":\"ok\",\"command\":\"enable\",\"latency_us\":%lu}\n", latency);
+                printf("{\"status\":\"ok\",\"command\":\"adaptive\",\"keepalive_hz\":%u,\"idle_frames\":%u,\"latency_us\":%lu}\n",
+                       keepalive_hz, idle_frames, latency);
                 break;
             case OUTPUT_QUIET:
                 /* Silent success */
                 break;
             case OUTPUT_HUMAN:
             default:
-                printf("✅ DMX enabled (latency: %lu µs)\n", latency);
+                if (keepalive_hz == 0) {
+                    printf("✅ Adaptive refresh disabled (latency: %lu µs)\n",
+                           latency);
+                } else {
+                    printf("✅ Adaptive refresh: idle drops to %u Hz (latency: %lu µs)\n",
+                           keepalive_hz, latency);
+                }
                 break;
         }
+    } else {
+        report_cmd_error(ret);
     }
 
     return ret;
 }
 
 /*
- * Disable DMX transmission
+ * Read back the universe state (channels + config) - recovery/debug aid
  */
-static int dmx_disable(int fd)
+static int dmx_get_universe(dmx_conn_t *conn)
 {
-    uint8_t resp_buf[16];
-    uint16_t resp_len;
+    dmx_universe_state_t state;
+
+    uint64_t t0 = get_time_us();
+    int ret = dmx_cmd_get_universe(conn, &state);
+    uint64_t t1 = get_time_us();
+    unsigned long latency = (unsigned long)(t1 - t0);
 
+    if (ret != DMX_OK) {
+        report_cmd_error(ret);
+        return ret;
+    }
+
+    int nonzero = 0;
+    for (int ch = 0; ch < DMX_MAX_CHANNELS; ch++) {
+        if (state.channels[ch]) {
+            nonzero++;
+        }
+    }
+
+    switch (g_output_format) {
+        case OUTPUT_JSON:
+            printf("{\"status\":\"ok\",\"command\":\"get_universe\",\"enabled\":%s,"
+                   "\"refresh_hz\":%d,\"break_us\":%d,\"mab_us\":%d,\"slots\":%d,"
+                   "\"nonzero\":%d,\"channels\":{",
+                   state.enabled ? "true" : "false",
+                   state.refresh_hz, state.break_us, state.mab_us, state.slots,
+                   nonzero);
+            {
+                /* Sparse map of the non-zero channels (1-indexed) */
+                int first = 1;
+                for (int ch = 0; ch < DMX_MAX_CHANNELS; ch++) {
+                    if (state.channels[ch]) {
+                        printf("%s\"%d\":%d", first ? "" : ",", ch + 1,
+                               state.channels[ch]);
+                        first = 0;
+                    }
+                }
+            }
+            printf("},\"latency_us\":%lu}\n", latency);
+            break;
+
+        case OUTPUT_QUIET:
+            /* Silent success */
+            break;
+
+        case OUTPUT_HUMAN:
+        default:
+            printf("✅ Universe state (latency: %lu µs)\n", latency);
+            printf("   Output:    %s\n", state.enabled ? "ENABLED" : "DISABLED");
+            printf("   Timing:    %d Hz, BREAK=%dµs, MAB=%dµs, %d slots\n",
+                   state.refresh_hz, state.break_us, state.mab_us, state.slots);
+            printf("   Channels:  %d non-zero\n", nonzero);
+            for (int ch = 0; ch < DMX_MAX_CHANNELS; ch++) {
+                if (state.channels[ch]) {
+                    printf("     ch %3d = %d\n", ch + 1, state.channels[ch]);
+                }
+            }
+            break;
+    }
+
+    return ret;
+}
+
+/*
+ * Store the current output into a firmware scene slot
+ */
+static int dmx_scene_store(dmx_conn_t *conn, uint8_t scene)
+{
     uint64_t t0 = get_time_us();
-    int ret = send_cmd_and_recv(fd, CMD_DMX_DISABLE, NULL, 0, resp_buf, sizeof(resp_buf), &resp_len);
+    int ret = dmx_cmd_scene_store(conn, scene);
     uint64_t t1 = get_time_us();
     unsigned long latency = (unsigned long)(t1 - t0);
 
-    if (ret == 0) {
+    if (ret == DMX_OK) {
         switch (g_output_format) {
             case OUTPUT_JSON:
-                printf("{\"status\":\"ok\",\"command\":\"disable\",\"latency_us\":%lu}\n", latency);
+                printf("{\"status\":\"ok\",\"command\":\"scene_store\",\"scene\":%d,\"latency_us\":%lu}\n",
+                       scene, latency);
                 break;
             case OUTPUT_QUIET:
                 /* Silent success */
                 break;
             case OUTPUT_HUMAN:
             default:
-                printf("✅ DMX disabled (latency: %lu µs)\n", latency);
+                printf("✅ Scene %d stored (latency: %lu µs)\n", scene, latency);
                 break;
         }
+    } else {
+        report_cmd_error(ret);
     }
 
     return ret;
 }
 
 /*
- * Set DMX channels
+ * Recall a stored scene (instant, or crossfaded when duration_ms > 0)
  */
-static int dmx_set_channels(int fd, uint16_t start_channel, const uint8_t *values, uint16_t count)
+static int dmx_scene_recall(dmx_conn_t *conn, uint8_t scene,
+                            uint16_t duration_ms, uint8_t easing)
 {
-    uint8_t payload[2 + DMX_MAX_CHANNELS];
-    payload[0] = start_channel & 0xFF;
-    payload[1] = (start_channel >> 8) & 0xFF;
-    memcpy(&payload[2], values, count);
-
-    uint8_t resp_buf[16];
-    uint16_t resp_len;
-
     uint64_t t0 = get_time_us();
-    int ret = send_cmd_and_recv(fd, CMD_DMX_SET_CHANNELS, payload, 2 + count,
-                                resp_buf, sizeof(resp_buf), &resp_len);
+    int ret = dmx_cmd_scene_recall(conn, scene, duration_ms, easing);
     uint64_t t1 = get_time_us();
     unsigned long latency = (unsigned long)(t1 - t0);
 
-    if (ret == 0) {
+    if (ret == DMX_OK) {
         switch (g_output_format) {
             case OUTPUT_JSON:
-                printf("{\"status\":\"ok\",\"command\":\"set\",\"start_channel\":%d,\"count\":%d,\"latency_us\":%lu}\n",
-                       start_channel, count, latency);
+                printf("{\"status\":\"ok\",\"command\":\"scene_recall\",\"scene\":%d,\"duration_ms\":%d,\"latency_us\":%lu}\n",
+                       scene, duration_ms, latency);
                 break;
             case OUTPUT_QUIET:
                 /* Silent success */
                 break;
             case OUTPUT_HUMAN:
             default:
-                printf("✅ Channels %d-%d set (latency: %lu µs)\n",
-                       start_channel, start_channel + count - 1, latency);
+                if (duration_ms > 0) {
+                    printf("✅ Scene %d recalled over %d ms (latency: %lu µs)\n",
+                           scene, duration_ms, latency);
+                } else {
+                    printf("✅ Scene %d recalled (latency: %lu µs)\n",
+                           scene, latency);
+                }
                 break;
         }
+    } else {
+        report_cmd_error(ret);
     }
 
     return ret;
@@ -340,27 +497,26 @@ static int dmx_set_channels(int fd, uint16_t start_channel, const uint8_t *value
 /*
  * Get DMX status
  */
-static int dmx_get_status(int fd)
+static int dmx_get_status(dmx_conn_t *conn)
 {
-    uint8_t resp_buf[sizeof(dmx_status_payload_t)];
-    uint16_t resp_len;
+    dmx_status_payload_t status;
 
     uint64_t t0 = get_time_us();
-    int ret = send_cmd_and_recv(fd, CMD_DMX_GET_STATUS, NULL, 0,
-                                resp_buf, sizeof(resp_buf), &resp_len);
+    int ret = dmx_cmd_get_status(conn, &status);
     uint64_t t1 = get_time_us();
     unsigned long latency = (unsigned long)(t1 - t0);
 
-    if (ret == 0 && resp_len == sizeof(dmx_status_payload_t)) {
-        dmx_status_payload_t *status = (dmx_status_payload_t *)resp_buf;
-        float fps = (float)status->fps / 100.0f;
+    if (ret == DMX_OK) {
+        float fps = (float)status.fps / 100.0f;
 
         switch (g_output_format) {
             case OUTPUT_JSON:
-                printf("{\"status\":\"ok\",\"command\":\"get_status\",\"enabled\":%s,\"frame_count\":%u,\"fps\":%.2f,\"latency_us\":%lu}\n",
-                       status->enabled ? "true" : "false",
-                       status->frame_count,
+                printf("{\"status\":\"ok\",\"command\":\"get_status\",\"enabled\":%s,\"frame_count\":%u,\"fps\":%.2f,\"effective_hz\":%u,\"throttled\":%s,\"latency_us\":%lu}\n",
+                       status.enabled ? "true" : "false",
+                       status.frame_count,
                        fps,
+                       status.effective_hz,
+                       status.throttled ? "true" : "false",
                        latency);
                 break;
             case OUTPUT_QUIET:
@@ -369,149 +525,1445 @@ static int dmx_get_status(int fd)
             case OUTPUT_HUMAN:
             default:
                 printf("✅ DMX Status (latency: %lu µs):\n", latency);
-                printf("   Enabled:      %s\n", status->enabled ? "Yes" : "No");
-                printf("   Frame count:  %u\n", status->frame_count);
+                printf("   Enabled:      %s\n", status.enabled ? "Yes" : "No");
+                printf("   Frame count:  %u\n", status.frame_count);
                 printf("   FPS:          %.2f Hz\n", fps);
+                printf("   Pacing:       %u Hz%s\n", status.effective_hz,
+                       status.throttled ? " (keep-alive, universe idle)" : "");
                 break;
         }
+    } else {
+        report_cmd_error(ret);
     }
 
     return ret;
 }
 
 /*
- * Blackout (all channels to 0)
+ * Get high-resolution frame timing stats
  */
-static int dmx_blackout(int fd)
+static int dmx_get_stats(dmx_conn_t *conn)
 {
-    uint8_t resp_buf[16];
-    uint16_t resp_len;
+    static const uint32_t edges[DMX_STATS_HIST_BINS] = DMX_STATS_HIST_EDGES;
+    dmx_stats_payload_t stats;
 
     uint64_t t0 = get_time_us();
-    int ret = send_cmd_and_recv(fd, CMD_DMX_BLACKOUT, NULL, 0,
-                                resp_buf, sizeof(resp_buf), &resp_len);
+    int ret = dmx_cmd_get_stats(conn, &stats);
     uint64_t t1 = get_time_us();
     unsigned long latency = (unsigned long)(t1 - t0);
 
-    if (ret == 0) {
+    if (ret == DMX_OK) {
         switch (g_output_format) {
             case OUTPUT_JSON:
-                printf("{\"status\":\"ok\",\"command\":\"blackout\",\"latency_us\":%lu}\n", latency);
+                printf("{\"status\":\"ok\",\"command\":\"get_stats\",\"frame_count\":%u,\"errors\":%u,"
+                       "\"skipped\":%u,\"samples\":%u,\"period_min_us\":%u,\"period_max_us\":%u,"
+                       "\"period_avg_us\":%u,\"period_p99_us\":%u,\"hist\":[",
+                       stats.frame_count, stats.errors, stats.skipped, stats.samples,
+                       stats.period_min_us, stats.period_max_us,
+                       stats.period_avg_us, stats.period_p99_us);
+                for (int i = 0; i < DMX_STATS_HIST_BINS; i++) {
+                    printf("%s%u", i ? "," : "", stats.hist[i]);
+                }
+                printf("],\"latency_us\":%lu}\n", latency);
                 break;
             case OUTPUT_QUIET:
                 /* Silent success */
                 break;
             case OUTPUT_HUMAN:
             default:
-                printf("✅ Blackout applied (latency: %lu µs)\n", latency);
+                printf("✅ DMX Frame Stats (latency: %lu µs):\n", latency);
+                printf("   Frames:   %u (errors: %u, skipped: %u)\n",
+                       stats.frame_count, stats.errors, stats.skipped);
+                if (stats.samples == 0) {
+                    printf("   No periods measured yet (enable transmission first)\n");
+                    break;
+                }
+                printf("   Period:   min=%u avg=%u p99=%u max=%u µs (%u samples)\n",
+                       stats.period_min_us, stats.period_avg_us,
+                       stats.period_p99_us, stats.period_max_us, stats.samples);
+                printf("   Jitter histogram (|period - nominal|):\n");
+                for (int i = 0; i < DMX_STATS_HIST_BINS; i++) {
+                    if (edges[i]) {
+                        printf("     <= %5u µs: %u\n", edges[i], stats.hist[i]);
+                    } else {
+                        printf("      > %5u µs: %u\n", edges[i - 1], stats.hist[i]);
+                    }
+                }
                 break;
         }
+    } else {
+        report_cmd_error(ret);
     }
 
     return ret;
 }
 
 /*
- * Set DMX timing (frame rate, BREAK, MAB)
- * Use 0 for any parameter to keep unchanged
+ * Run a wire-level timing capture (loopback jig) and print the report
+ *
+ * Arms the firmware capture, polls until it has collected the requested
+ * frames, then reports BREAK+MAB, slot and frame period distributions.
  */
-static int dmx_set_timing(int fd, uint16_t refresh_hz, uint16_t break_us, uint16_t mab_us)
+static int dmx_capture(dmx_conn_t *conn, int frames)
 {
-    dmx_timing_t timing;
-    timing.refresh_hz = refresh_hz;
-    timing.break_us = break_us;
-    timing.mab_us = mab_us;
+    static const uint32_t edges[DMX_STATS_HIST_BINS] = DMX_STATS_HIST_EDGES;
+    dmx_capture_payload_t rep;
+
+    uint64_t t0 = get_time_us();
+    int ret = dmx_cmd_capture_start(conn, frames);
+    if (ret != DMX_OK) {
+        report_cmd_error(ret);
+        return ret;
+    }
+
+    /* Poll until done. At 44Hz a frame is ~23ms; allow double that per
+     * frame plus slack before declaring the capture stuck (no signal on
+     * the loopback means no frames ever complete). */
+    int budget_ms = frames * 50 + 2000;
+    do {
+        usleep(100000);
+        budget_ms -= 100;
+        ret = dmx_cmd_capture_report(conn, &rep);
+        if (ret != DMX_OK) {
+            report_cmd_error(ret);
+            return ret;
+        }
+    } while (rep.running && budget_ms > 0);
+
+    unsigned long elapsed = (unsigned long)(get_time_us() - t0);
+
+    if (rep.running) {
+        if (g_output_format == OUTPUT_JSON) {
+            printf("{\"status\":\"error\",\"error\":\"Capture timeout - no signal on loopback?\",\"frames\":%u}\n",
+                   rep.frames);
+        } else if (g_output_format != OUTPUT_QUIET) {
+            fprintf(stderr, "Error: capture timeout after %u/%d frames - no signal on loopback?\n",
+                    rep.frames, frames);
+        }
+        return 1;
+    }
 
-    uint8_t resp_buf[16];
-    uint16_t resp_len;
+    switch (g_output_format) {
+        case OUTPUT_JSON:
+            printf("{\"status\":\"ok\",\"command\":\"capture\",\"frames\":%u,\"bytes\":%u,"
+                   "\"errors\":%u,\"break_mab_min_us\":%u,\"break_mab_avg_us\":%u,"
+                   "\"break_mab_max_us\":%u,\"slot_min_us\":%u,\"slot_avg_us\":%u,"
+                   "\"slot_max_us\":%u,\"period_min_us\":%u,\"period_avg_us\":%u,"
+                   "\"period_max_us\":%u,\"hist\":[",
+                   rep.frames, rep.bytes, rep.errors,
+                   rep.break_mab_min_us, rep.break_mab_avg_us, rep.break_mab_max_us,
+                   rep.slot_min_us, rep.slot_avg_us, rep.slot_max_us,
+                   rep.period_min_us, rep.period_avg_us, rep.period_max_us);
+            for (int i = 0; i < DMX_STATS_HIST_BINS; i++) {
+                printf("%s%u", i ? "," : "", rep.hist[i]);
+            }
+            printf("],\"elapsed_us\":%lu}\n", elapsed);
+            break;
+        case OUTPUT_QUIET:
+            /* Silent success */
+            break;
+        case OUTPUT_HUMAN:
+        default:
+            printf("✅ Wire capture: %u frames, %u bytes (errors: %u, %.1f s)\n",
+                   rep.frames, rep.bytes, rep.errors,
+                   (double)elapsed / 1000000.0);
+            printf("   BREAK+MAB: min=%u avg=%u max=%u µs\n",
+                   rep.break_mab_min_us, rep.break_mab_avg_us, rep.break_mab_max_us);
+            printf("   Slot:      min=%u avg=%u max=%u µs (44 nominal)\n",
+                   rep.slot_min_us, rep.slot_avg_us, rep.slot_max_us);
+            printf("   Period:    min=%u avg=%u max=%u µs\n",
+                   rep.period_min_us, rep.period_avg_us, rep.period_max_us);
+            printf("   Slot deviation histogram (|slot - 44µs|):\n");
+            for (int i = 0; i < DMX_STATS_HIST_BINS; i++) {
+                if (edges[i]) {
+                    printf("     <= %5u µs: %u\n", edges[i], rep.hist[i]);
+                } else {
+                    printf("      > %5u µs: %u\n", edges[i - 1], rep.hist[i]);
+                }
+            }
+            break;
+    }
 
+    return 0;
+}
+
+/*
+ * Blackout (all channels to 0)
+ */
+static int dmx_blackout(dmx_conn_t *conn)
+{
     uint64_t t0 = get_time_us();
-    int ret = send_cmd_and_recv(fd, CMD_DMX_SET_TIMING, (uint8_t *)&timing, sizeof(timing),
-                                resp_buf, sizeof(resp_buf), &resp_len);
+    int ret = dmx_cmd_blackout(conn);
     uint64_t t1 = get_time_us();
     unsigned long latency = (unsigned long)(t1 - t0);
 
-    if (ret == 0) {
+    if (ret == DMX_OK) {
         switch (g_output_format) {
             case OUTPUT_JSON:
-                printf("{\"status\":\"ok\",\"command\":\"set_timing\",\"refresh_hz\":%d,\"break_us\":%d,\"mab_us\":%d,\"latency_us\":%lu}\n",
-                       refresh_hz, break_us, mab_us, latency);
+                printf("{\"status\":\"ok\",\"command\":\"blackout\",\"latency_us\":%lu}\n", latency);
                 break;
             case OUTPUT_QUIET:
                 /* Silent success */
                 break;
             case OUTPUT_HUMAN:
             default:
-                printf("✅ Timing set: %dHz, BREAK=%dµs, MAB=%dµs (0=unchanged) (latency: %lu µs)\n",
-                       refresh_hz, break_us, mab_us, latency);
+                printf("✅ Blackout applied (latency: %lu µs)\n", latency);
                 break;
         }
+    } else {
+        report_cmd_error(ret);
     }
 
     return ret;
 }
 
 /*
- * Get DMX timing configuration
+ * Set DMX timing (frame rate, BREAK, MAB, slots)
+ * Use 0 for any parameter to keep unchanged
  */
-static int dmx_get_timing(int fd)
+static int dmx_set_timing(dmx_conn_t *conn, uint16_t refresh_hz, uint16_t break_us,
+                          uint16_t mab_us, uint16_t slots)
 {
-    uint8_t resp_buf[sizeof(dmx_timing_payload_t)];
-    uint16_t resp_len;
-
     uint64_t t0 = get_time_us();
-    int ret = send_cmd_and_recv(fd, CMD_DMX_GET_TIMING, NULL, 0,
-                                resp_buf, sizeof(resp_buf), &resp_len);
+    int ret = dmx_cmd_set_timing(conn, refresh_hz, break_us, mab_us, slots);
     uint64_t t1 = get_time_us();
     unsigned long latency = (unsigned long)(t1 - t0);
 
-    if (ret == 0 && resp_len == sizeof(dmx_timing_payload_t)) {
-        dmx_timing_payload_t *timing = (dmx_timing_payload_t *)resp_buf;
-
+    if (ret == DMX_OK) {
         switch (g_output_format) {
             case OUTPUT_JSON:
-                printf("{\"status\":\"ok\",\"command\":\"get_timing\",\"refresh_hz\":%u,\"break_us\":%u,\"mab_us\":%u,\"latency_us\":%lu}\n",
-                       timing->refresh_hz, timing->break_us, timing->mab_us, latency);
+                printf("{\"status\":\"ok\",\"command\":\"set_timing\",\"refresh_hz\":%d,\"break_us\":%d,\"mab_us\":%d,\"slots\":%d,\"latency_us\":%lu}\n",
+                       refresh_hz, break_us, mab_us, slots, latency);
                 break;
             case OUTPUT_QUIET:
                 /* Silent success */
                 break;
             case OUTPUT_HUMAN:
             default:
-                printf("✅ DMX Timing (latency: %lu µs):\n", latency);
-                printf("   Refresh: %u Hz\n", timing->refresh_hz);
-                printf("   BREAK:   %u µs\n", timing->break_us);
-                printf("   MAB:     %u µs\n", timing->mab_us);
+                printf("✅ Timing set: %dHz, BREAK=%dµs, MAB=%dµs, %d slots (0=unchanged) (latency: %lu µs)\n",
+                       refresh_hz, break_us, mab_us, slots, latency);
                 break;
         }
+    } else {
+        report_cmd_error(ret);
     }
 
     return ret;
 }
 
-/* ============================================================================
- * CLI Interface
- * ============================================================================ */
-
-static void print_usage(const char *prog)
+/*
+ * Get DMX timing configuration
+ */
+static int dmx_get_timing(dmx_conn_t *conn)
 {
-    printf("DMX512 Client CLI\n\n");
+    dmx_timing_payload_t timing;
 
-    printf("USAGE:\n");
-    printf("  %s <command> [options] [--json|--quiet]\n\n", prog);
+    uint64_t t0 = get_time_us();
+    int ret = dmx_cmd_get_timing(conn, &timing);
+    uint64_t t1 = get_time_us();
+    unsigned long latency = (unsigned long)(t1 - t0);
+
+    if (ret == DMX_OK) {
+        switch (g_output_format) {
+            case OUTPUT_JSON:
+                printf("{\"status\":\"ok\",\"command\":\"get_timing\",\"refresh_hz\":%u,\"break_us\":%u,\"mab_us\":%u,\"slots\":%u,\"latency_us\":%lu}\n",
+                       timing.refresh_hz, timing.break_us, timing.mab_us, timing.slots, latency);
+                break;
+            case OUTPUT_QUIET:
+                /* Silent success */
+                break;
+            case OUTPUT_HUMAN:
+            default:
+                printf("✅ DMX Timing (latency: %lu µs):\n", latency);
+                printf("   Refresh: %u Hz\n", timing.refresh_hz);
+                printf("   BREAK:   %u µs\n", timing.break_us);
+                printf("   MAB:     %u µs\n", timing.mab_us);
+                if (timing.slots != 0) {
+                    printf("   Slots:   %u channels/frame\n", timing.slots);
+                }
+                break;
+        }
+    } else {
+        report_cmd_error(ret);
+    }
+
+    return ret;
+}
+
+/* ============================================================================
+ * Stream Mode (binary frames on stdin)
+ * ============================================================================ */
+
+/*
+ * Stream mode: read length-prefixed binary SET_CHANNELS records from stdin
+ *
+ * Record format (all little-endian):
+ *   [len:2] [payload:len]        with payload = [start_channel:2] [values:N]
+ *
+ * i.e. the payload is exactly the CMD_DMX_SET_CHANNELS wire payload. Each
+ * record goes straight through dmx_build_cmd_packet() - no text parsing -
+ * so a pipe from the gateway can sustain 44Hz x 512-channel updates.
+ *
+ * Returns: 0 on clean EOF, 1 on error
+ */
+static int run_stream(dmx_conn_t *conn)
+{
+    uint8_t payload[2 + DMX_MAX_CHANNELS];
+    uint8_t len_buf[2];
+    unsigned long frames = 0;
+
+    uint64_t t0 = get_time_us();
+
+    for (;;) {
+        /* Record length prefix */
+        size_t n = fread(len_buf, 1, 2, stdin);
+        if (n == 0) {
+            break;  /* Clean EOF between records */
+        }
+        if (n != 2) {
+            if (g_output_format != OUTPUT_QUIET) {
+                fprintf(stderr, "Error: stream: truncated length prefix\n");
+            }
+            return 1;
+        }
+
+        uint16_t len = len_buf[0] | (len_buf[1] << 8);
+        if (len < 3 || len > sizeof(payload)) {
+            if (g_output_format != OUTPUT_QUIET) {
+                fprintf(stderr, "Error: stream: invalid record length %u (3-%u)\n",
+                        len, (unsigned)sizeof(payload));
+            }
+            return 1;
+        }
+
+        if (fread(payload, 1, len, stdin) != len) {
+            if (g_output_format != OUTPUT_QUIET) {
+                fprintf(stderr, "Error: stream: truncated record payload\n");
+            }
+            return 1;
+        }
+
+        int ret;
+        if (g_shm) {
+            /* Zero-copy: publish straight into the shared-memory mirror */
+            uint16_t start = payload[0] | (payload[1] << 8);
+            ret = dmx_shm_publish(g_shm, start, &payload[2], len - 2);
+        } else {
+            ret = dmx_send_cmd(conn, CMD_DMX_SET_CHANNELS, payload, len, NULL, 0, NULL);
+        }
+        if (ret != DMX_OK) {
+            report_cmd_error(ret);
+            return 1;
+        }
+        frames++;
+    }
+
+    uint64_t elapsed_us = get_time_us() - t0;
+
+    switch (g_output_format) {
+        case OUTPUT_JSON:
+            printf("{\"status\":\"ok\",\"command\":\"stream\",\"frames\":%lu,\"elapsed_us\":%llu}\n",
+                   frames, (unsigned long long)elapsed_us);
+            break;
+        case OUTPUT_QUIET:
+            /* Silent success */
+            break;
+        case OUTPUT_HUMAN:
+        default:
+            printf("✅ Streamed %lu frames in %llu µs\n",
+                   frames, (unsigned long long)elapsed_us);
+            break;
+    }
+
+    return 0;
+}
+
+/* ============================================================================
+ * Watch Mode (pushed status events)
+ * ============================================================================ */
+
+static volatile sig_atomic_t g_watch_running = 1;
+
+static void watch_signal_handler(int sig)
+{
+    (void)sig;
+    g_watch_running = 0;
+}
+
+/*
+ * Watch mode: dmx watch [--interval <ms>]
+ *
+ * Subscribes once (CMD_DMX_SUBSCRIBE), then reads pushed status events
+ * on the open connection until Ctrl-C. One JSON line per event, so a
+ * dashboard pipes this into its collector instead of forking a status
+ * subprocess per sample - one long-lived fd instead of 86400 execs a
+ * day at 1Hz. AP firmware only (the MCU rejects the subscribe and this
+ * falls through to the error report).
+ *
+ * Returns: 0 on clean shutdown, 1 on error
+ */
+static int run_watch(dmx_conn_t *conn, int interval_ms)
+{
+    int ret = dmx_cmd_subscribe(conn, (uint16_t)interval_ms);
+    if (ret != DMX_OK) {
+        report_cmd_error(ret);
+        return 1;
+    }
+
+    signal(SIGINT, watch_signal_handler);
+    signal(SIGTERM, watch_signal_handler);
+    signal(SIGPIPE, watch_signal_handler);   /* Collector went away */
+
+    unsigned long events = 0;
+
+    while (g_watch_running) {
+        uint8_t type = 0;
+        uint16_t len = 0;
+        dmx_status_payload_t status;
+
+        ret = dmx_recv_event(conn, &type, (uint8_t *)&status,
+                             sizeof(status), &len);
+        if (ret == DMX_ERR_TIMEOUT) {
+            continue;   /* Interval longer than the connection timeout */
+        }
+        if (ret != DMX_OK) {
+            report_cmd_error(ret);
+            break;
+        }
+        if (type != CMD_DMX_GET_STATUS || len != sizeof(status)) {
+            continue;   /* Unknown event type - skip, don't die */
+        }
+
+        float fps = (float)status.fps / 100.0f;
+        switch (g_output_format) {
+            case OUTPUT_JSON:
+                printf("{\"event\":\"status\",\"t_us\":%llu,\"enabled\":%s,\"frame_count\":%u,\"fps\":%.2f,\"effective_hz\":%u,\"throttled\":%s}\n",
+                       (unsigned long long)get_time_us(),
+                       status.enabled ? "true" : "false",
+                       status.frame_count, fps, status.effective_hz,
+                       status.throttled ? "true" : "false");
+                break;
+            case OUTPUT_QUIET:
+                break;
+            case OUTPUT_HUMAN:
+            default:
+                printf("frames=%u fps=%.2f pacing=%uHz%s%s\n",
+                       status.frame_count, fps, status.effective_hz,
+                       status.throttled ? " (keep-alive)" : "",
+                       status.enabled ? "" : " [DISABLED]");
+                break;
+        }
+        fflush(stdout);
+        events++;
+    }
+
+    /* Stop the firmware pushing into a closing fd; the event-skip loop
+     * in the response readers eats any event racing the ack */
+    dmx_cmd_subscribe(conn, 0);
+
+    if (g_output_format == OUTPUT_HUMAN) {
+        fprintf(stderr, "Watch stopped after %lu events\n", events);
+    }
+    return (ret == DMX_OK || ret == DMX_ERR_TIMEOUT) ? 0 : 1;
+}
+
+/* ============================================================================
+ * Cue Player Mode (mmap'd binary sequences)
+ * ============================================================================ */
+
+/*
+ * Binary cue file format (all little-endian)
+ *
+ * Header (16 bytes):
+ *   [magic:4]        "DMXC" (0x43584D44 as u32)
+ *   [version:2]      1
+ *   [rsvd:2]
+ *   [frame_count:4]
+ *   [rsvd:4]
+ *
+ * Frame records, frame_count of them, sorted by timestamp:
+ *   [t_us:4]         playback time relative to start (µs)
+ *   [start:2]        first channel, 0-indexed
+ *   [count:2]        channel values that follow (1-512)
+ *   [values:count]
+ *
+ * Sequences are pre-computed offline; this player mmaps the file,
+ * pre-builds every wire packet once at load time, then the steady-state
+ * loop is clock_nanosleep() + write() on prebuilt buffers - no packet
+ * assembly, no syscalls beyond the two per frame, so playback CPU stays
+ * near zero regardless of sequence length.
+ */
+#define CUE_MAGIC        0x43584D44u  /* "DMXC" */
+#define CUE_VERSION      1
+#define CUE_HEADER_SIZE  16
+#define CUE_RECORD_MIN   (4 + 2 + 2 + 1)
+
+/* One prebuilt packet: offset into the packet arena + wire length */
+typedef struct {
+    uint32_t t_us;      /* Playback time relative to start */
+    uint32_t offset;    /* Byte offset into the packet arena */
+    uint16_t len;       /* Wire packet length */
+} cue_frame_t;
+
+static uint32_t cue_rd32(const uint8_t *p)
+{
+    return (uint32_t)p[0] | ((uint32_t)p[1] << 8) |
+           ((uint32_t)p[2] << 16) | ((uint32_t)p[3] << 24);
+}
+
+static uint16_t cue_rd16(const uint8_t *p)
+{
+    return (uint16_t)(p[0] | (p[1] << 8));
+}
+
+/*
+ * Play a pre-computed cue file: dmx play <file> [loops]
+ *
+ * loops defaults to 1; 0 loops forever. Packets are sent
+ * fire-and-forget (NO_ACK) so the loop never blocks on responses -
+ * errors count in the firmware error counter and surface via 'status'.
+ *
+ * Returns: 0 on success, 1 on error
+ */
+static int run_play(dmx_conn_t *conn, const char *path, long loops)
+{
+    int ret = 1;
+    int fd = -1;
+    uint8_t *map = MAP_FAILED;
+    size_t map_len = 0;
+    cue_frame_t *frames = NULL;
+    uint8_t *arena = NULL;
+
+    fd = open(path, O_RDONLY);
+    if (fd < 0) {
+        if (g_output_format != OUTPUT_QUIET) {
+            fprintf(stderr, "Error: play: cannot open %s: %s\n",
+                    path, strerror(errno));
+        }
+        goto out;
+    }
+
+    struct stat st;
+    if (fstat(fd, &st) < 0 || st.st_size < CUE_HEADER_SIZE) {
+        if (g_output_format != OUTPUT_QUIET) {
+            fprintf(stderr, "Error: play: %s is not a cue file\n", path);
+        }
+        goto out;
+    }
+
+    map_len = (size_t)st.st_size;
+    map = mmap(NULL, map_len, PROT_READ, MAP_PRIVATE, fd, 0);
+    if (map == MAP_FAILED) {
+        if (g_output_format != OUTPUT_QUIET) {
+            fprintf(stderr, "Error: play: mmap failed: %s\n", strerror(errno));
+        }
+        goto out;
+    }
+
+    if (cue_rd32(&map[0]) != CUE_MAGIC || cue_rd16(&map[4]) != CUE_VERSION) {
+        if (g_output_format != OUTPUT_QUIET) {
+            fprintf(stderr, "Error: play: bad magic/version in %s\n", path);
+        }
+        goto out;
+    }
+
+    uint32_t frame_count = cue_rd32(&map[8]);
+    if (frame_count == 0) {
+        if (g_output_format != OUTPUT_QUIET) {
+            fprintf(stderr, "Error: play: empty cue file\n");
+        }
+        goto out;
+    }
+
+    /*
+     * Load pass: validate every record and pre-build its wire packet.
+     * Worst-case arena size is bounded by the file size itself (the
+     * packet adds a constant few header bytes per record).
+     */
+    frames = malloc(frame_count * sizeof(cue_frame_t));
+    arena = malloc(map_len + (size_t)frame_count * 16);
+    if (!frames || !arena) {
+        if (g_output_format != OUTPUT_QUIET) {
+            fprintf(stderr, "Error: play: out of memory\n");
+        }
+        goto out;
+    }
+
+    size_t pos = CUE_HEADER_SIZE;
+    uint32_t arena_used = 0;
+    uint32_t prev_t = 0;
+
+    for (uint32_t i = 0; i < frame_count; i++) {
+        if (pos + CUE_RECORD_MIN > map_len) {
+            if (g_output_format != OUTPUT_QUIET) {
+                fprintf(stderr, "Error: play: truncated at record %u\n", i);
+            }
+            goto out;
+        }
+
+        uint32_t t_us = cue_rd32(&map[pos]);
+        uint16_t start = cue_rd16(&map[pos + 4]);
+        uint16_t count = cue_rd16(&map[pos + 6]);
+
+        if (count == 0 || start + count > DMX_MAX_CHANNELS ||
+            pos + 8 + count > map_len || t_us < prev_t) {
+            if (g_output_format != OUTPUT_QUIET) {
+                fprintf(stderr, "Error: play: invalid record %u "
+                        "(start=%u count=%u t=%uµs)\n", i, start, count, t_us);
+            }
+            goto out;
+        }
+        prev_t = t_us;
+
+        /* SET_CHANNELS payload = [start:2][values:N], same as the wire */
+        uint8_t payload[2 + DMX_MAX_CHANNELS];
+        payload[0] = start & 0xFF;
+        payload[1] = (start >> 8) & 0xFF;
+        memcpy(&payload[2], &map[pos + 8], count);
+
+        int pkt_len;
+        if (g_universe != 0) {
+            pkt_len = dmx_build_cmd_packet_v2(&arena[arena_used],
+                                              CMD_DMX_SET_CHANNELS | DMX_CMD_FLAG_NO_ACK,
+                                              (uint8_t)i, (uint8_t)g_universe,
+                                              payload, 2 + count);
+        } else {
+            pkt_len = dmx_build_cmd_packet(&arena[arena_used],
+                                           CMD_DMX_SET_CHANNELS | DMX_CMD_FLAG_NO_ACK,
+                                           payload, 2 + count);
+        }
+
+        frames[i].t_us = t_us;
+        frames[i].offset = arena_used;
+        frames[i].len = (uint16_t)pkt_len;
+        arena_used += pkt_len;
+        pos += 8 + count;
+    }
+
+    /* The cue data is fully baked into the arena now */
+    munmap(map, map_len);
+    map = MAP_FAILED;
+    close(fd);
+    fd = -1;
+
+    int dev_fd = dmx_fd(conn);
+    uint32_t cue_span_us = frames[frame_count - 1].t_us;
+    unsigned long sent = 0;
+    unsigned long late = 0;
+
+    struct timespec base;
+    clock_gettime(CLOCK_MONOTONIC, &base);
+
+    for (long loop = 0; loops == 0 || loop < loops; loop++) {
+        /* Each pass shifts the schedule by the span of the previous one
+         * plus one nominal 44Hz frame gap, so looping doesn't double-hit
+         * t=0 */
+        uint64_t loop_off_us = (uint64_t)loop * (cue_span_us + 1000000ull / 44);
+
+        for (uint32_t i = 0; i < frame_count; i++) {
+            uint64_t due_us = loop_off_us + frames[i].t_us;
+            struct timespec due = base;
+            due.tv_sec += (time_t)(due_us / 1000000);
+            due.tv_nsec += (long)(due_us % 1000000) * 1000;
+            if (due.tv_nsec >= 1000000000L) {
+                due.tv_sec++;
+                due.tv_nsec -= 1000000000L;
+            }
+
+            /* Absolute-time pacing: never accumulates drift, returns
+             * immediately when we're already behind schedule */
+            clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &due, NULL);
+
+            struct timespec now;
+            clock_gettime(CLOCK_MONOTONIC, &now);
+            uint64_t now_us = (uint64_t)(now.tv_sec - base.tv_sec) * 1000000 +
+                              (now.tv_nsec - base.tv_nsec) / 1000;
+            if (now_us > due_us + 1000) {
+                late++;  /* More than 1ms behind the cue timestamp */
+            }
+
+            if (write(dev_fd, &arena[frames[i].offset], frames[i].len)
+                    != (ssize_t)frames[i].len) {
+                if (g_output_format != OUTPUT_QUIET) {
+                    fprintf(stderr, "Error: play: write failed: %s\n",
+                            strerror(errno));
+                }
+                goto out;
+            }
+            sent++;
+        }
+    }
+
+    struct timespec end;
+    clock_gettime(CLOCK_MONOTONIC, &end);
+    uint64_t elapsed_us = (uint64_t)(end.tv_sec - base.tv_sec) * 1000000 +
+                          (end.tv_nsec - base.tv_nsec) / 1000;
+
+    switch (g_output_format) {
+        case OUTPUT_JSON:
+            printf("{\"status\":\"ok\",\"command\":\"play\",\"frames\":%lu,"
+                   "\"late\":%lu,\"elapsed_us\":%llu}\n",
+                   sent, late, (unsigned long long)elapsed_us);
+            break;
+        case OUTPUT_QUIET:
+            /* Silent success */
+            break;
+        case OUTPUT_HUMAN:
+        default:
+            printf("✅ Played %lu frames in %llu.%03llu s (%lu late)\n",
+                   sent, (unsigned long long)(elapsed_us / 1000000),
+                   (unsigned long long)(elapsed_us % 1000000) / 1000, late);
+            break;
+    }
+    ret = 0;
+
+out:
+    free(arena);
+    free(frames);
+    if (map != MAP_FAILED) {
+        munmap(map, map_len);
+    }
+    if (fd >= 0) {
+        close(fd);
+    }
+    return ret;
+}
+
+/* ============================================================================
+ * Benchmark Mode (RPMSG latency / throughput)
+ * ============================================================================ */
+
+/* Round trips excluded from the stats while caches/endpoints warm up */
+#define BENCH_WARMUP_ITERS   10
+/* Upper bound on recorded samples (stream mode runs until a deadline) */
+#define BENCH_MAX_SAMPLES    1000000
+
+/* qsort comparator for latency samples */
+static int bench_cmp_u32(const void *a, const void *b)
+{
+    uint32_t x = *(const uint32_t *)a;
+    uint32_t y = *(const uint32_t *)b;
+    return (x > y) - (x < y);
+}
+
+/* p-th percentile of a sorted sample array (nearest-rank) */
+static uint32_t bench_percentile(const uint32_t *sorted, unsigned long n, int p)
+{
+    unsigned long idx = (n * (unsigned long)p + 99) / 100;
+    if (idx > 0) {
+        idx--;
+    }
+    return sorted[idx];
+}
+
+/*
+ * Benchmark the RPMSG link with repeatable workloads
+ *
+ * Two modes, both driving CMD_DMX_SET_CHANNELS through the normal
+ * synchronous path so the numbers match what applications see:
+ *
+ *   bench rtt [iters] [bytes]      N round trips with a <bytes>-channel
+ *                                  payload (defaults: 1000 iters, 64 bytes)
+ *   bench stream [secs] [bytes]    sustained streaming for <secs> seconds
+ *                                  (defaults: 5 s, 64 bytes)
+ *
+ * Reports min/p50/p90/p99/max/avg per-command latency and achieved
+ * commands/sec. Warmup iterations are excluded. With --no-ack the
+ * "latency" is just the write() cost - useful for measuring the
+ * fire-and-forget path, but not a round trip.
+ *
+ * Returns: 0 on success, 1 on error
+ */
+static int run_bench(dmx_conn_t *conn, int argc, char *argv[])
+{
+    bool stream_mode = false;
+    long param = 0;
+    int payload_bytes = 64;
+
+    if (argc >= 3) {
+        if (strcmp(argv[2], "stream") == 0) {
+            stream_mode = true;
+        } else if (strcmp(argv[2], "rtt") != 0) {
+            if (g_output_format == OUTPUT_JSON) {
+                printf("{\"status\":\"error\",\"error\":\"bench mode must be rtt or stream\"}\n");
+            } else if (g_output_format != OUTPUT_QUIET) {
+                fprintf(stderr, "Error: bench mode must be 'rtt' or 'stream'\n");
+            }
+            return 1;
+        }
+    }
+    param = (argc >= 4) ? atol(argv[3]) : (stream_mode ? 5 : 1000);
+    if (argc >= 5) {
+        payload_bytes = atoi(argv[4]);
+    }
+
+    if (param < 1 || (stream_mode ? param > 3600 : param > BENCH_MAX_SAMPLES)) {
+        if (g_output_format == OUTPUT_JSON) {
+            printf("{\"status\":\"error\",\"error\":\"bench count out of range\"}\n");
+        } else if (g_output_format != OUTPUT_QUIET) {
+            fprintf(stderr, "Error: bench %s must be 1-%d\n",
+                    stream_mode ? "seconds" : "iterations",
+                    stream_mode ? 3600 : BENCH_MAX_SAMPLES);
+        }
+        return 1;
+    }
+    if (payload_bytes < 1 || payload_bytes > DMX_MAX_CHANNELS) {
+        if (g_output_format == OUTPUT_JSON) {
+            printf("{\"status\":\"error\",\"error\":\"Payload must be 1-%d bytes\"}\n", DMX_MAX_CHANNELS);
+        } else if (g_output_format != OUTPUT_QUIET) {
+            fprintf(stderr, "Error: payload must be 1-%d bytes\n", DMX_MAX_CHANNELS);
+        }
+        return 1;
+    }
+
+    uint32_t *samples = malloc(BENCH_MAX_SAMPLES * sizeof(uint32_t));
+    if (!samples) {
+        if (g_output_format != OUTPUT_QUIET) {
+            fprintf(stderr, "Error: out of memory\n");
+        }
+        return 1;
+    }
+
+    /* Ramp pattern - deterministic, cheap to regenerate on the far side
+     * if we ever add payload verification */
+    uint8_t values[DMX_MAX_CHANNELS];
+    for (int i = 0; i < payload_bytes; i++) {
+        values[i] = (uint8_t)i;
+    }
+
+    /* Warmup (not recorded) */
+    for (int i = 0; i < BENCH_WARMUP_ITERS; i++) {
+        int ret = dmx_cmd_set_channels(conn, 0, values, payload_bytes);
+        if (ret != DMX_OK) {
+            free(samples);
+            report_cmd_error(ret);
+            return 1;
+        }
+    }
+
+    unsigned long n = 0;
+    uint64_t deadline = stream_mode ? get_time_us() + (uint64_t)param * 1000000 : 0;
+    uint64_t bench_t0 = get_time_us();
+
+    for (;;) {
+        if (stream_mode) {
+            if (get_time_us() >= deadline || n >= BENCH_MAX_SAMPLES) {
+                break;
+            }
+        } else if (n >= (unsigned long)param) {
+            break;
+        }
+
+        uint64_t t0 = get_time_us();
+        int ret = dmx_cmd_set_channels(conn, 0, values, payload_bytes);
+        uint64_t t1 = get_time_us();
+
+        if (ret != DMX_OK) {
+            free(samples);
+            report_cmd_error(ret);
+            return 1;
+        }
+        samples[n++] = (uint32_t)(t1 - t0);
+    }
+
+    uint64_t elapsed_us = get_time_us() - bench_t0;
+    if (elapsed_us == 0) {
+        elapsed_us = 1;
+    }
+
+    uint64_t sum = 0;
+    for (unsigned long i = 0; i < n; i++) {
+        sum += samples[i];
+    }
+    qsort(samples, n, sizeof(uint32_t), bench_cmp_u32);
+
+    uint32_t lat_min = samples[0];
+    uint32_t lat_max = samples[n - 1];
+    uint32_t lat_p50 = bench_percentile(samples, n, 50);
+    uint32_t lat_p90 = bench_percentile(samples, n, 90);
+    uint32_t lat_p99 = bench_percentile(samples, n, 99);
+    uint32_t lat_avg = (uint32_t)(sum / n);
+    double cmds_per_sec = (double)n * 1000000.0 / (double)elapsed_us;
+
+    free(samples);
+
+    switch (g_output_format) {
+        case OUTPUT_JSON:
+            printf("{\"status\":\"ok\",\"command\":\"bench\",\"mode\":\"%s\",\"device\":\"%s\","
+                   "\"payload_bytes\":%d,\"no_ack\":%s,\"iterations\":%lu,\"elapsed_us\":%llu,"
+                   "\"cmds_per_sec\":%.1f,\"lat_min_us\":%u,\"lat_p50_us\":%u,\"lat_p90_us\":%u,"
+                   "\"lat_p99_us\":%u,\"lat_max_us\":%u,\"lat_avg_us\":%u}\n",
+                   stream_mode ? "stream" : "rtt", g_device,
+                   payload_bytes, g_no_ack ? "true" : "false",
+                   n, (unsigned long long)elapsed_us, cmds_per_sec,
+                   lat_min, lat_p50, lat_p90, lat_p99, lat_max, lat_avg);
+            break;
+        case OUTPUT_QUIET:
+            /* Silent success */
+            break;
+        case OUTPUT_HUMAN:
+        default:
+            printf("✅ Bench %s: %lu commands in %.3f s (%s, %d-byte payload%s)\n",
+                   stream_mode ? "stream" : "rtt", n,
+                   (double)elapsed_us / 1000000.0, g_device, payload_bytes,
+                   g_no_ack ? ", no-ack" : "");
+            printf("   Throughput: %.1f cmds/sec\n", cmds_per_sec);
+            printf("   Latency:    min=%u p50=%u p90=%u p99=%u max=%u avg=%u µs\n",
+                   lat_min, lat_p50, lat_p90, lat_p99, lat_max, lat_avg);
+            break;
+    }
+
+    return 0;
+}
+
+/* ============================================================================
+ * Command Dispatch
+ * ============================================================================ */
+
+static void print_usage(const char *prog);
+
+/*
+ * Execute one CLI command against an open connection
+ *
+ * argv[1] is the command verb, argv[2..] its arguments - same layout as
+ * main()'s argv, so the daemon can reuse the CLI vocabulary verbatim.
+ *
+ * Returns: 0 on success, 1 on error
+ */
+static int run_command(dmx_conn_t *conn, int argc, char *argv[])
+{
+    int ret = 0;
+    const char *cmd = argv[1];
+
+    if (strcmp(cmd, "enable") == 0) {
+        ret = dmx_enable(conn);
+    }
+    else if (strcmp(cmd, "disable") == 0) {
+        ret = dmx_disable(conn);
+    }
+    else if (strcmp(cmd, "status") == 0) {
+        ret = dmx_get_status(conn);
+    }
+    else if (strcmp(cmd, "stats") == 0) {
+        ret = dmx_get_stats(conn);
+    }
+    else if (strcmp(cmd, "universe") == 0) {
+        ret = dmx_get_universe(conn);
+    }
+    else if (strcmp(cmd, "adaptive") == 0 && argc >= 3) {
+        /* adaptive off | adaptive <keepalive_hz> [idle_frames] */
+        if (strcmp(argv[2], "off") == 0) {
+            ret = dmx_set_adaptive_mode(conn, 0, 0);
+        } else {
+            int keepalive_hz = atoi(argv[2]);
+            int idle_frames = (argc >= 4) ? atoi(argv[3]) : 0;
+            if (keepalive_hz < 1 || keepalive_hz > 44 ||
+                idle_frames < 0 || idle_frames > 65535) {
+                if (g_output_format == OUTPUT_JSON) {
+                    printf("{\"status\":\"error\",\"error\":\"Keep-alive rate must be 1-44 Hz\"}\n");
+                } else if (g_output_format != OUTPUT_QUIET) {
+                    fprintf(stderr, "Error: Keep-alive rate must be 1-44 Hz\n");
+                }
+                return 1;
+            }
+            ret = dmx_set_adaptive_mode(conn, (uint16_t)keepalive_hz,
+                                        (uint16_t)idle_frames);
+        }
+    }
+    else if (strcmp(cmd, "capture") == 0) {
+        int frames = (argc >= 3) ? atoi(argv[2]) : 44;
+        if (frames < 1 || frames > DMX_CAPTURE_MAX_FRAMES) {
+            if (g_output_format == OUTPUT_JSON) {
+                printf("{\"status\":\"error\",\"error\":\"Frames must be 1-%d\"}\n",
+                       DMX_CAPTURE_MAX_FRAMES);
+            } else if (g_output_format != OUTPUT_QUIET) {
+                fprintf(stderr, "Error: frames must be 1-%d\n", DMX_CAPTURE_MAX_FRAMES);
+            }
+            return 1;
+        }
+        ret = dmx_capture(conn, frames);
+    }
+    else if (strcmp(cmd, "blackout") == 0) {
+        ret = dmx_blackout(conn);
+    }
+    else if (strcmp(cmd, "timing") == 0) {
+        if (argc >= 3) {
+            /* Set timing: timing [fps] [break] [mab] [slots] - 0 means unchanged */
+            int refresh_hz = atoi(argv[2]);
+            int break_us = (argc >= 4) ? atoi(argv[3]) : 0;
+            int mab_us = (argc >= 5) ? atoi(argv[4]) : 0;
+            int slots = (argc >= 6) ? atoi(argv[5]) : 0;
+
+            /* Validate ranges (0 = unchanged, skip validation). The upper
+             * refresh bound depends on the frame length (~44Hz at 512
+             * slots, ~290Hz at 64) - the firmware enforces it exactly. */
+            if (refresh_hz != 0 && (refresh_hz < 1 || refresh_hz > 1000)) {
+                if (g_output_format == OUTPUT_JSON) {
+                    printf("{\"status\":\"error\",\"error\":\"Refresh must be 1-1000 Hz (or 0=unchanged)\"}\n");
+                } else if (g_output_format != OUTPUT_QUIET) {
+                    fprintf(stderr, "Error: Refresh must be 1-1000 Hz (or 0=unchanged)\n");
+                }
+                return 1;
+            }
+            if (slots != 0 && (slots < 1 || slots > 512)) {
+                if (g_output_format == OUTPUT_JSON) {
+                    printf("{\"status\":\"error\",\"error\":\"Slots must be 1-512 (or 0=unchanged)\"}\n");
+                } else if (g_output_format != OUTPUT_QUIET) {
+                    fprintf(stderr, "Error: Slots must be 1-512 (or 0=unchanged)\n");
+                }
+                return 1;
+            }
+            if (break_us != 0 && (break_us < 88 || break_us > 1000)) {
+                if (g_output_format == OUTPUT_JSON) {
+                    printf("{\"status\":\"error\",\"error\":\"BREAK must be 88-1000 µs (or 0=unchanged)\"}\n");
+                } else if (g_output_format != OUTPUT_QUIET) {
+                    fprintf(stderr, "Error: BREAK must be 88-1000 µs (or 0=unchanged)\n");
+                }
+                return 1;
+            }
+            if (mab_us != 0 && (mab_us < 8 || mab_us > 100)) {
+                if (g_output_format == OUTPUT_JSON) {
+                    printf("{\"status\":\"error\",\"error\":\"MAB must be 8-100 µs (or 0=unchanged)\"}\n");
+                } else if (g_output_format != OUTPUT_QUIET) {
+                    fprintf(stderr, "Error: MAB must be 8-100 µs (or 0=unchanged)\n");
+                }
+                return 1;
+            }
+
+            ret = dmx_set_timing(conn, refresh_hz, break_us, mab_us, slots);
+        } else {
+            /* Get timing: timing (no args) */
+            ret = dmx_get_timing(conn);
+        }
+    }
+    else if (strcmp(cmd, "stream") == 0) {
+        ret = run_stream(conn);
+    }
+    else if (strcmp(cmd, "watch") == 0) {
+        ret = run_watch(conn, g_watch_interval_ms);
+    }
+    else if (strcmp(cmd, "play") == 0 && argc >= 3) {
+        long loops = (argc >= 4) ? atol(argv[3]) : 1;
+        if (loops < 0) {
+            if (g_output_format == OUTPUT_JSON) {
+                printf("{\"status\":\"error\",\"error\":\"Loops must be >= 0\"}\n");
+            } else if (g_output_format != OUTPUT_QUIET) {
+                fprintf(stderr, "Error: Loops must be >= 0 (0 = forever)\n");
+            }
+            return 1;
+        }
+        ret = run_play(conn, argv[2], loops);
+    }
+    else if (strcmp(cmd, "bench") == 0) {
+        ret = run_bench(conn, argc, argv);
+    }
+    else if (strcmp(cmd, "set") == 0 && argc >= 4) {
+        /* Parse channel number */
+        int channel = atoi(argv[2]);
+        if (channel < 1 || channel > DMX_MAX_CHANNELS) {
+            if (g_output_format == OUTPUT_JSON) {
+                printf("{\"status\":\"error\",\"error\":\"Channel must be 1-%d\"}\n", DMX_MAX_CHANNELS);
+            } else if (g_output_format != OUTPUT_QUIET) {
+                fprintf(stderr, "Error: Channel must be 1-%d\n", DMX_MAX_CHANNELS);
+            }
+            return 1;
+        }
+
+        /* Parse values (comma-separated or single) */
+        uint8_t values[DMX_MAX_CHANNELS];
+        int count = 0;
+
+        char *values_str = argv[3];
+        char *token = strtok(values_str, ",");
+        while (token && count < DMX_MAX_CHANNELS) {
+            int val = atoi(token);
+            if (val < 0 || val > 255) {
+                if (g_output_format == OUTPUT_JSON) {
+                    printf("{\"status\":\"error\",\"error\":\"Value must be 0-255\"}\n");
+                } else if (g_output_format != OUTPUT_QUIET) {
+                    fprintf(stderr, "Error: Value must be 0-255\n");
+                }
+                return 1;
+            }
+            values[count++] = (uint8_t)val;
+            token = strtok(NULL, ",");
+        }
+
+        ret = dmx_set_channels(conn, channel - 1, values, count);  /* 0-indexed internally */
+    }
+    else if (strcmp(cmd, "sparse") == 0 && argc >= 3) {
+        /* Parse ch=val pairs (comma-separated): sparse 1=255,57=10 */
+        uint16_t channels[DMX_MAX_CHANNELS];
+        uint8_t values[DMX_MAX_CHANNELS];
+        int count = 0;
+
+        char *pairs_str = argv[2];
+        char *token = strtok(pairs_str, ",");
+        while (token && count < DMX_MAX_CHANNELS) {
+            char *eq = strchr(token, '=');
+            int channel = atoi(token);
+            int val = eq ? atoi(eq + 1) : -1;
+
+            if (!eq || channel < 1 || channel > DMX_MAX_CHANNELS || val < 0 || val > 255) {
+                if (g_output_format == OUTPUT_JSON) {
+                    printf("{\"status\":\"error\",\"error\":\"Expected ch=val with ch 1-%d, val 0-255\"}\n",
+                           DMX_MAX_CHANNELS);
+                } else if (g_output_format != OUTPUT_QUIET) {
+                    fprintf(stderr, "Error: Expected ch=val with ch 1-%d, val 0-255 (got '%s')\n",
+                            DMX_MAX_CHANNELS, token);
+                }
+                return 1;
+            }
+
+            channels[count] = (uint16_t)(channel - 1);  /* 0-indexed internally */
+            values[count] = (uint8_t)val;
+            count++;
+            token = strtok(NULL, ",");
+        }
+
+        ret = dmx_set_sparse(conn, channels, values, count);
+    }
+    else if (strcmp(cmd, "stage") == 0 && argc >= 4) {
+        /* stage <start_ch> <v1,v2,...> - same shape as set, pending only */
+        int channel = atoi(argv[2]);
+        if (channel < 1 || channel > DMX_MAX_CHANNELS) {
+            if (g_output_format == OUTPUT_JSON) {
+                printf("{\"status\":\"error\",\"error\":\"Channel must be 1-%d\"}\n", DMX_MAX_CHANNELS);
+            } else if (g_output_format != OUTPUT_QUIET) {
+                fprintf(stderr, "Error: Channel must be 1-%d\n", DMX_MAX_CHANNELS);
+            }
+            return 1;
+        }
+
+        uint8_t values[DMX_MAX_CHANNELS];
+        int count = 0;
+
+        char *token = strtok(argv[3], ",");
+        while (token && count < DMX_MAX_CHANNELS) {
+            int val = atoi(token);
+            if (val < 0 || val > 255) {
+                if (g_output_format == OUTPUT_JSON) {
+                    printf("{\"status\":\"error\",\"error\":\"Value must be 0-255\"}\n");
+                } else if (g_output_format != OUTPUT_QUIET) {
+                    fprintf(stderr, "Error: Value must be 0-255\n");
+                }
+                return 1;
+            }
+            values[count++] = (uint8_t)val;
+            token = strtok(NULL, ",");
+        }
+
+        ret = dmx_stage(conn, channel - 1, values, count);  /* 0-indexed internally */
+    }
+    else if (strcmp(cmd, "commit") == 0) {
+        ret = dmx_commit(conn);
+    }
+    else if (strcmp(cmd, "fade") == 0 && argc >= 5) {
+        /* fade <start_ch> <v1,v2,...> <duration_ms> [ease] */
+        int channel = atoi(argv[2]);
+        if (channel < 1 || channel > DMX_MAX_CHANNELS) {
+            if (g_output_format == OUTPUT_JSON) {
+                printf("{\"status\":\"error\",\"error\":\"Channel must be 1-%d\"}\n", DMX_MAX_CHANNELS);
+            } else if (g_output_format != OUTPUT_QUIET) {
+                fprintf(stderr, "Error: Channel must be 1-%d\n", DMX_MAX_CHANNELS);
+            }
+            return 1;
+        }
+
+        /* Parse target values (comma-separated or single) */
+        uint8_t targets[DMX_MAX_CHANNELS];
+        int count = 0;
+
+        char *token = strtok(argv[3], ",");
+        while (token && count < DMX_MAX_CHANNELS) {
+            int val = atoi(token);
+            if (val < 0 || val > 255) {
+                if (g_output_format == OUTPUT_JSON) {
+                    printf("{\"status\":\"error\",\"error\":\"Value must be 0-255\"}\n");
+                } else if (g_output_format != OUTPUT_QUIET) {
+                    fprintf(stderr, "Error: Value must be 0-255\n");
+                }
+                return 1;
+            }
+            targets[count++] = (uint8_t)val;
+            token = strtok(NULL, ",");
+        }
+
+        int duration_ms = atoi(argv[4]);
+        if (duration_ms < 0 || duration_ms > DMX_FADE_MAX_MS) {
+            if (g_output_format == OUTPUT_JSON) {
+                printf("{\"status\":\"error\",\"error\":\"Duration must be 0-%d ms\"}\n", DMX_FADE_MAX_MS);
+            } else if (g_output_format != OUTPUT_QUIET) {
+                fprintf(stderr, "Error: Duration must be 0-%d ms\n", DMX_FADE_MAX_MS);
+            }
+            return 1;
+        }
+
+        uint8_t easing = (argc >= 6 && strcmp(argv[5], "ease") == 0)
+                             ? DMX_FADE_EASE : DMX_FADE_LINEAR;
+
+        ret = dmx_fade(conn, channel - 1, targets, count, duration_ms, easing);  /* 0-indexed internally */
+    }
+    else if (strcmp(cmd, "scene") == 0 && argc >= 4) {
+        /* scene store <n> | scene recall <n> [duration_ms] [ease] */
+        int scene = atoi(argv[3]);
+        if (scene < 0 || scene >= DMX_SCENE_COUNT) {
+            if (g_output_format == OUTPUT_JSON) {
+                printf("{\"status\":\"error\",\"error\":\"Scene must be 0-%d\"}\n", DMX_SCENE_COUNT - 1);
+            } else if (g_output_format != OUTPUT_QUIET) {
+                fprintf(stderr, "Error: Scene must be 0-%d\n", DMX_SCENE_COUNT - 1);
+            }
+            return 1;
+        }
+
+        if (strcmp(argv[2], "store") == 0) {
+            ret = dmx_scene_store(conn, (uint8_t)scene);
+        } else if (strcmp(argv[2], "recall") == 0) {
+            int duration_ms = (argc >= 5) ? atoi(argv[4]) : 0;
+            if (duration_ms < 0 || duration_ms > DMX_FADE_MAX_MS) {
+                if (g_output_format == OUTPUT_JSON) {
+                    printf("{\"status\":\"error\",\"error\":\"Duration must be 0-%d ms\"}\n", DMX_FADE_MAX_MS);
+                } else if (g_output_format != OUTPUT_QUIET) {
+                    fprintf(stderr, "Error: Duration must be 0-%d ms\n", DMX_FADE_MAX_MS);
+                }
+                return 1;
+            }
+            uint8_t easing = (argc >= 6 && strcmp(argv[5], "ease") == 0)
+                                 ? DMX_FADE_EASE : DMX_FADE_LINEAR;
+            ret = dmx_scene_recall(conn, (uint8_t)scene,
+                                   (uint16_t)duration_ms, easing);
+        } else {
+            if (g_output_format == OUTPUT_JSON) {
+                printf("{\"status\":\"error\",\"error\":\"Scene action must be store or recall\"}\n");
+            } else if (g_output_format != OUTPUT_QUIET) {
+                fprintf(stderr, "Error: Scene action must be 'store' or 'recall'\n");
+            }
+            return 1;
+        }
+    }
+    else {
+        if (g_output_format == OUTPUT_JSON) {
+            printf("{\"status\":\"error\",\"error\":\"Unknown command: %s\"}\n", cmd);
+        } else if (g_output_format != OUTPUT_QUIET) {
+            fprintf(stderr, "Error: Unknown command '%s'\n", cmd);
+            print_usage(argv[0]);
+        }
+        ret = 1;
+    }
+
+    return ret ? 1 : 0;
+}
+
+/* ============================================================================
+ * Daemon Mode (Unix socket)
+ * ============================================================================ */
+
+static volatile sig_atomic_t g_daemon_running = 1;
+
+static void daemon_signal_handler(int sig)
+{
+    (void)sig;
+    g_daemon_running = 0;
+}
+
+/*
+ * Split a command line into argv[] tokens (in place)
+ *
+ * argv[0] is a dummy program name so run_command() sees the same argv
+ * layout as main().
+ *
+ * Returns: argc
+ */
+static int tokenize_line(char *line, char *argv[], int max_args)
+{
+    int argc = 1;
+    argv[0] = "dmx";
+
+    char *token = strtok(line, " \t\r\n");
+    while (token && argc < max_args) {
+        argv[argc++] = token;
+        token = strtok(NULL, " \t\r\n");
+    }
+    return argc;
+}
+
+/*
+ * Daemon mode: hold the RPMSG fd open, serve commands over a Unix socket.
+ *
+ * The gateway connects once and sends one CLI command line per request
+ * ("set 1 255,128\n", "status\n", ...). Each command gets one JSON line
+ * back - the same vocabulary and responses as the one-shot CLI, minus
+ * the fork/exec + open + termios setup per command.
+ *
+ * Returns: 0 on clean shutdown, 1 on setup error
+ */
+static int run_daemon(dmx_conn_t *conn)
+{
+    int listen_fd;
+    struct sockaddr_un addr;
+
+    /* Socket clients always get JSON (one line per command) */
+    g_output_format = OUTPUT_JSON;
+
+    signal(SIGINT, daemon_signal_handler);
+    signal(SIGTERM, daemon_signal_handler);
+    signal(SIGPIPE, SIG_IGN);
+
+    listen_fd = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (listen_fd < 0) {
+        fprintf(stderr, "Error: socket: %s\n", strerror(errno));
+        return 1;
+    }
+
+    /* Remove stale socket from a previous run */
+    unlink(g_socket_path);
+
+    memset(&addr, 0, sizeof(addr));
+    addr.sun_family = AF_UNIX;
+    strncpy(addr.sun_path, g_socket_path, sizeof(addr.sun_path) - 1);
+
+    if (bind(listen_fd, (struct sockaddr *)&addr, sizeof(addr)) < 0) {
+        fprintf(stderr, "Error: bind %s: %s\n", g_socket_path, strerror(errno));
+        close(listen_fd);
+        return 1;
+    }
+
+    if (listen(listen_fd, 4) < 0) {
+        fprintf(stderr, "Error: listen: %s\n", strerror(errno));
+        close(listen_fd);
+        return 1;
+    }
+
+    fprintf(stderr, "dmx daemon: listening on %s (device: %s)\n", g_socket_path, g_device);
+
+    while (g_daemon_running) {
+        int conn_fd = accept(listen_fd, NULL, NULL);
+        if (conn_fd < 0) {
+            if (errno == EINTR) continue;
+            fprintf(stderr, "Error: accept: %s\n", strerror(errno));
+            break;
+        }
+
+        FILE *in = fdopen(conn_fd, "r");
+        if (!in) {
+            close(conn_fd);
+            continue;
+        }
+
+        /* Serve command lines until the client disconnects */
+        char line[4096];
+        while (g_daemon_running && fgets(line, sizeof(line), in)) {
+            char *cmd_argv[16];
+            int cmd_argc = tokenize_line(line, cmd_argv, 16);
+            if (cmd_argc < 2) {
+                continue;  /* Empty line */
+            }
+
+            /*
+             * Redirect stdout to the connection so the existing JSON
+             * printf paths answer the socket client directly.
+             */
+            int saved_stdout = dup(STDOUT_FILENO);
+            dup2(conn_fd, STDOUT_FILENO);
+
+            run_command(conn, cmd_argc, cmd_argv);
+
+            fflush(stdout);
+            dup2(saved_stdout, STDOUT_FILENO);
+            close(saved_stdout);
+        }
+
+        fclose(in);  /* Also closes conn_fd */
+    }
+
+    close(listen_fd);
+    unlink(g_socket_path);
+    fprintf(stderr, "dmx daemon: stopped\n");
+    return 0;
+}
+
+/* ============================================================================
+ * CLI Interface
+ * ============================================================================ */
+
+static void print_usage(const char *prog)
+{
+    printf("DMX512 Client CLI\n\n");
+
+    printf("USAGE:\n");
+    printf("  %s <command> [options] [--json|--quiet]\n\n", prog);
 
     printf("COMMANDS:\n");
     printf("  enable                          Enable DMX transmission\n");
     printf("  disable                         Disable DMX transmission\n");
     printf("  set <ch> <val>                  Set single channel (1-512, 0-255)\n");
     printf("  set <ch> <v1,v2,...>            Set multiple channels\n");
+    printf("  sparse <ch=val,ch=val,...>      Set non-contiguous channels\n");
+    printf("  fade <ch> <v1,...> <ms> [ease]  Fade channels to targets over <ms>\n");
+    printf("                                  (firmware interpolates per frame)\n");
+    printf("  stage <ch> <v1,v2,...>          Stage channels (pending, not live)\n");
+    printf("  commit                          Apply staged channels at the next\n");
+    printf("                                  frame (tear-free cue application)\n");
     printf("  status                          Get DMX status\n");
+    printf("  stats                           Get frame timing stats (period\n");
+    printf("                                  min/avg/p99/max + jitter histogram)\n");
+    printf("  universe                        Read back the full universe state\n");
+    printf("                                  (enable, timing, live channels) -\n");
+    printf("                                  resync after a Linux reboot without\n");
+    printf("                                  disturbing the running output\n");
+    printf("  capture [frames]                Wire-level timing check (default 44\n");
+    printf("                                  frames; needs UART3 TX looped back\n");
+    printf("                                  to UART5 RX on the test jig)\n");
+    printf("  scene store <n>                 Snapshot the current output into\n");
+    printf("                                  scene slot n (0-%d, kept in firmware)\n", DMX_SCENE_COUNT - 1);
+    printf("  scene recall <n> [ms] [ease]    Recall a scene: instant atomic swap,\n");
+    printf("                                  or crossfade over [ms] milliseconds\n");
     printf("  blackout                        Set all channels to 0\n");
-    printf("  timing [fps] [break] [mab]      Set timing (0=unchanged)\n");
-    printf("  timing                          Get current timing config\n\n");
+    printf("  timing [fps] [break] [mab] [slots]  Set timing (0=unchanged; fewer\n");
+    printf("                                  slots allow higher refresh rates)\n");
+    printf("  timing                          Get current timing config\n");
+    printf("  adaptive <hz> [frames]          Drop to <hz> keep-alive rate after\n");
+    printf("                                  [frames] unchanged frames (default ~2s);\n");
+    printf("                                  snaps back on the first write\n");
+    printf("  adaptive off                    Disable adaptive refresh\n");
+    printf("  stream                          Read binary SET_CHANNELS records from\n");
+    printf("                                  stdin ([len:2][start:2][values:N], LE)\n");
+    printf("  watch                           Subscribe to pushed status events and\n");
+    printf("                                  print one line each (JSON lines with\n");
+    printf("                                  --json) until Ctrl-C - no per-sample\n");
+    printf("                                  subprocess or round trip\n");
+    printf("  play <file> [loops]             Play a pre-computed binary cue file\n");
+    printf("                                  (mmap'd, packets prebuilt at load;\n");
+    printf("                                  loops=0 repeats forever)\n");
+    printf("  bench rtt [iters] [bytes]       Benchmark the RPMSG link: N round trips\n");
+    printf("                                  (default 1000) of a <bytes>-channel\n");
+    printf("                                  SET_CHANNELS (default 64)\n");
+    printf("  bench stream [secs] [bytes]     Sustained streaming for <secs> seconds\n");
+    printf("                                  (default 5); reports latency percentiles\n");
+    printf("                                  and achieved cmds/sec\n\n");
+
+    printf("DAEMON MODE:\n");
+    printf("  --daemon                        Hold device open, serve commands over\n");
+    printf("                                  a Unix socket (one command line per\n");
+    printf("                                  request, JSON response per line)\n\n");
 
     printf("FLAGS:\n");
     printf("  -d, --device <path>             Device path (default: %s)\n", DEFAULT_DEV);
+    printf("  --socket <path>                 Daemon socket path (default: %s)\n", DEFAULT_SOCKET);
+    printf("  -u, --universe <n>              Target universe (default: 0; non-zero\n");
+    printf("                                  universes use v2 framing)\n");
+    printf("  --no-ack                        Fire-and-forget write commands (no response\n");
+    printf("                                  wait; errors count in firmware stats)\n");
+    printf("  --interval <ms>                 Watch mode push period (default 1000,\n");
+    printf("                                  min %d)\n", DMX_SUB_INTERVAL_MIN_MS);
+    printf("  --transport <tty|rpmsg-raw>     Transport backend (default: tty).\n");
+    printf("                                  rpmsg-raw talks to the firmware's raw\n");
+    printf("                                  endpoint via rpmsg_char - no tty layer,\n");
+    printf("                                  one message per packet (-d names the\n");
+    printf("                                  rpmsg_ctrl or rpmsg endpoint device)\n");
+    printf("  --shm                           Publish channel data (set/stream) through\n");
+    printf("                                  the shared-memory mirror instead of RPMSG\n");
+    printf("                                  (zero-copy, needs root for /dev/mem)\n");
     printf("  --json                          Output JSON (for scripts/subprocess)\n");
     printf("  --quiet, -q                     Minimal output (exit code only)\n\n");
 
@@ -519,7 +1971,13 @@ static void print_usage(const char *prog)
     printf("  # Human-friendly output (default)\n");
     printf("  %s enable\n", prog);
     printf("  %s set 1 255\n", prog);
-    printf("  %s set 1 255,128,64,32,16\n\n", prog);
+    printf("  %s set 1 255,128,64,32,16\n", prog);
+    printf("  %s sparse 1=255,57=10,300=128\n", prog);
+    printf("  %s fade 1 255,255,255 2000 ease\n\n", prog);
+
+    printf("  # Tear-free cue across both outputs: stage bulk data, then commit\n");
+    printf("  %s stage 1 255,128,64 && %s -d /dev/ttyRPMSG1 stage 1 0,0,255\n", prog, prog);
+    printf("  %s commit && %s -d /dev/ttyRPMSG1 commit\n\n", prog, prog);
 
     printf("  # Use MCU universe (ttyRPMSG1)\n");
     printf("  %s -d /dev/ttyRPMSG1 status\n", prog);
@@ -532,6 +1990,10 @@ static void print_usage(const char *prog)
     printf("  # Quiet mode (exit code only)\n");
     printf("  %s enable --quiet && echo Success\n\n", prog);
 
+    printf("  # Daemon mode (gateway sends commands over the socket)\n");
+    printf("  %s --daemon &\n", prog);
+    printf("  echo 'set 1 255,128,64' | nc -U %s\n\n", DEFAULT_SOCKET);
+
     printf("JSON RESPONSE FORMATS:\n");
     printf("  enable/disable/set/blackout:\n");
     printf("    {\"status\":\"ok\",\"command\":\"enable\",\"latency_us\":245}\n\n");
@@ -542,11 +2004,11 @@ static void print_usage(const char *prog)
 
     printf("  timing (get):\n");
     printf("    {\"status\":\"ok\",\"command\":\"get_timing\",\"break_us\":400,\n");
-    printf("     \"mab_us\":40,\"latency_us\":251}\n\n");
+    printf("     \"mab_us\":40,\"slots\":512,\"latency_us\":251}\n\n");
 
     printf("  timing (set):\n");
     printf("    {\"status\":\"ok\",\"command\":\"set_timing\",\"break_us\":400,\n");
-    printf("     \"mab_us\":40,\"latency_us\":247}\n\n");
+    printf("     \"mab_us\":40,\"slots\":512,\"latency_us\":247}\n\n");
 
     printf("EXIT CODES:\n");
     printf("  0   Success\n");
@@ -560,7 +2022,7 @@ int main(int argc, char *argv[])
         return 1;
     }
 
-    /* Parse global flags (--json, --quiet, --device) */
+    /* Parse global flags (--json, --quiet, --device, --socket) */
     for (int i = 1; i < argc; i++) {
         if (strcmp(argv[i], "--json") == 0) {
             g_output_format = OUTPUT_JSON;
@@ -586,6 +2048,70 @@ int main(int argc, char *argv[])
             }
             argc -= 2;
             i--;
+        } else if (strcmp(argv[i], "--shm") == 0) {
+            g_use_shm = true;
+            /* Remove flag from argv */
+            for (int j = i; j < argc - 1; j++) {
+                argv[j] = argv[j + 1];
+            }
+            argc--;
+            i--;
+        } else if ((strcmp(argv[i], "--universe") == 0 || strcmp(argv[i], "-u") == 0) && i + 1 < argc) {
+            g_universe = atoi(argv[i + 1]);
+            if (g_universe < 0 || g_universe > 255) {
+                fprintf(stderr, "Error: Invalid universe %d (0-255)\n", g_universe);
+                return 1;
+            }
+            /* Remove flag and value from argv */
+            for (int j = i; j < argc - 2; j++) {
+                argv[j] = argv[j + 2];
+            }
+            argc -= 2;
+            i--;
+        } else if (strcmp(argv[i], "--transport") == 0 && i + 1 < argc) {
+            if (strcmp(argv[i + 1], "rpmsg-raw") == 0) {
+                g_raw_transport = true;
+            } else if (strcmp(argv[i + 1], "tty") != 0) {
+                fprintf(stderr, "Error: Unknown transport '%s' (tty, rpmsg-raw)\n",
+                        argv[i + 1]);
+                return 1;
+            }
+            /* Remove flag and value from argv */
+            for (int j = i; j < argc - 2; j++) {
+                argv[j] = argv[j + 2];
+            }
+            argc -= 2;
+            i--;
+        } else if (strcmp(argv[i], "--interval") == 0 && i + 1 < argc) {
+            g_watch_interval_ms = atoi(argv[i + 1]);
+            if (g_watch_interval_ms < DMX_SUB_INTERVAL_MIN_MS ||
+                g_watch_interval_ms > 65535) {
+                fprintf(stderr, "Error: Interval must be %d-65535 ms\n",
+                        DMX_SUB_INTERVAL_MIN_MS);
+                return 1;
+            }
+            /* Remove flag and value from argv */
+            for (int j = i; j < argc - 2; j++) {
+                argv[j] = argv[j + 2];
+            }
+            argc -= 2;
+            i--;
+        } else if (strcmp(argv[i], "--no-ack") == 0) {
+            g_no_ack = true;
+            /* Remove flag from argv */
+            for (int j = i; j < argc - 1; j++) {
+                argv[j] = argv[j + 1];
+            }
+            argc--;
+            i--;
+        } else if (strcmp(argv[i], "--socket") == 0 && i + 1 < argc) {
+            g_socket_path = argv[i + 1];
+            /* Remove flag and value from argv */
+            for (int j = i; j < argc - 2; j++) {
+                argv[j] = argv[j + 2];
+            }
+            argc -= 2;
+            i--;
         }
     }
 
@@ -603,9 +2129,17 @@ int main(int argc, char *argv[])
         return 0;
     }
 
-    /* Open RPMSG device */
-    int fd = open(g_device, O_RDWR | O_NOCTTY);
-    if (fd < 0) {
+    /* Open RPMSG device (raw mode configured by libdmx). With
+     * --transport rpmsg-raw an unchanged -d still means "the default",
+     * which for that transport is the rpmsg control device. */
+    dmx_conn_t *conn;
+    if (g_raw_transport) {
+        conn = dmx_open_raw(strcmp(g_device, DEFAULT_DEV) == 0 ? NULL
+                                                              : g_device);
+    } else {
+        conn = dmx_open(g_device);
+    }
+    if (!conn) {
         if (g_output_format == OUTPUT_JSON) {
             printf("{\"status\":\"error\",\"error\":\"Failed to open %s: %s\"}\n",
                    g_device, strerror(errno));
@@ -615,121 +2149,59 @@ int main(int argc, char *argv[])
         return 1;
     }
 
-    /* Configure TTY for raw binary mode */
-    if (configure_tty_raw(fd) < 0) {
-        if (g_output_format == OUTPUT_JSON) {
-            printf("{\"status\":\"error\",\"error\":\"Failed to configure raw mode\"}\n");
-        } else if (g_output_format != OUTPUT_QUIET) {
-            fprintf(stderr, "Error: Failed to configure raw mode\n");
-        }
-        close(fd);
-        return 1;
+    if (g_no_ack) {
+        dmx_set_no_ack(conn, 1);
     }
 
-    int ret = 0;
-    const char *cmd = argv[1];
-
-    if (strcmp(cmd, "enable") == 0) {
-        ret = dmx_enable(fd);
+    if (g_universe != 0) {
+        dmx_set_universe(conn, (uint8_t)g_universe);
     }
-    else if (strcmp(cmd, "disable") == 0) {
-        ret = dmx_disable(fd);
-    }
-    else if (strcmp(cmd, "status") == 0) {
-        ret = dmx_get_status(fd);
-    }
-    else if (strcmp(cmd, "blackout") == 0) {
-        ret = dmx_blackout(fd);
-    }
-    else if (strcmp(cmd, "timing") == 0) {
-        if (argc >= 3) {
-            /* Set timing: timing [fps] [break] [mab] - 0 means unchanged */
-            int refresh_hz = atoi(argv[2]);
-            int break_us = (argc >= 4) ? atoi(argv[3]) : 0;
-            int mab_us = (argc >= 5) ? atoi(argv[4]) : 0;
-
-            /* Validate ranges (0 = unchanged, skip validation) */
-            if (refresh_hz != 0 && (refresh_hz < 1 || refresh_hz > 44)) {
-                if (g_output_format == OUTPUT_JSON) {
-                    printf("{\"status\":\"error\",\"error\":\"Refresh must be 1-44 Hz (or 0=unchanged)\"}\n");
-                } else if (g_output_format != OUTPUT_QUIET) {
-                    fprintf(stderr, "Error: Refresh must be 1-44 Hz (or 0=unchanged)\n");
-                }
-                ret = 1;
-                goto cleanup;
-            }
-            if (break_us != 0 && (break_us < 88 || break_us > 1000)) {
-                if (g_output_format == OUTPUT_JSON) {
-                    printf("{\"status\":\"error\",\"error\":\"BREAK must be 88-1000 µs (or 0=unchanged)\"}\n");
-                } else if (g_output_format != OUTPUT_QUIET) {
-                    fprintf(stderr, "Error: BREAK must be 88-1000 µs (or 0=unchanged)\n");
-                }
-                ret = 1;
-                goto cleanup;
-            }
-            if (mab_us != 0 && (mab_us < 8 || mab_us > 100)) {
-                if (g_output_format == OUTPUT_JSON) {
-                    printf("{\"status\":\"error\",\"error\":\"MAB must be 8-100 µs (or 0=unchanged)\"}\n");
-                } else if (g_output_format != OUTPUT_QUIET) {
-                    fprintf(stderr, "Error: MAB must be 8-100 µs (or 0=unchanged)\n");
-                }
-                ret = 1;
-                goto cleanup;
-            }
 
-            ret = dmx_set_timing(fd, refresh_hz, break_us, mab_us);
-        } else {
-            /* Get timing: timing (no args) */
-            ret = dmx_get_timing(fd);
+    /* Map the shared-memory mirror (channel data bypasses RPMSG).
+     * The mirror carries universe 0 only - there is a single region. */
+    if (g_use_shm && g_universe != 0) {
+        if (g_output_format == OUTPUT_JSON) {
+            printf("{\"status\":\"error\",\"error\":\"--shm only supports universe 0\"}\n");
+        } else if (g_output_format != OUTPUT_QUIET) {
+            fprintf(stderr, "Error: --shm only supports universe 0\n");
         }
+        dmx_close(conn);
+        return 1;
     }
-    else if (strcmp(cmd, "set") == 0 && argc >= 4) {
-        /* Parse channel number */
-        int channel = atoi(argv[2]);
-        if (channel < 1 || channel > DMX_MAX_CHANNELS) {
+    if (g_use_shm) {
+        g_shm = dmx_shm_open();
+        if (!g_shm) {
             if (g_output_format == OUTPUT_JSON) {
-                printf("{\"status\":\"error\",\"error\":\"Channel must be 1-%d\"}\n", DMX_MAX_CHANNELS);
+                printf("{\"status\":\"error\",\"error\":\"Failed to map shared memory: %s\"}\n",
+                       strerror(errno));
             } else if (g_output_format != OUTPUT_QUIET) {
-                fprintf(stderr, "Error: Channel must be 1-%d\n", DMX_MAX_CHANNELS);
+                fprintf(stderr, "Error: Failed to map shared memory: %s (need root for /dev/mem)\n",
+                        strerror(errno));
             }
-            ret = 1;
-            goto cleanup;
+            dmx_close(conn);
+            return 1;
         }
-
-        /* Parse values (comma-separated or single) */
-        uint8_t values[DMX_MAX_CHANNELS];
-        int count = 0;
-
-        char *values_str = argv[3];
-        char *token = strtok(values_str, ",");
-        while (token && count < DMX_MAX_CHANNELS) {
-            int val = atoi(token);
-            if (val < 0 || val > 255) {
-                if (g_output_format == OUTPUT_JSON) {
-                    printf("{\"status\":\"error\",\"error\":\"Value must be 0-255\"}\n");
-                } else if (g_output_format != OUTPUT_QUIET) {
-                    fprintf(stderr, "Error: Value must be 0-255\n");
-                }
-                ret = 1;
-                goto cleanup;
+        if (!dmx_shm_ready(g_shm)) {
+            if (g_output_format == OUTPUT_JSON) {
+                printf("{\"status\":\"error\",\"error\":\"Shared-memory mirror not initialized by firmware\"}\n");
+            } else if (g_output_format != OUTPUT_QUIET) {
+                fprintf(stderr, "Error: Shared-memory mirror not initialized by firmware\n");
             }
-            values[count++] = (uint8_t)val;
-            token = strtok(NULL, ",");
+            dmx_shm_close(g_shm);
+            dmx_close(conn);
+            return 1;
         }
-
-        ret = dmx_set_channels(fd, channel - 1, values, count);  /* 0-indexed internally */
     }
-    else {
-        if (g_output_format == OUTPUT_JSON) {
-            printf("{\"status\":\"error\",\"error\":\"Unknown command: %s\"}\n", cmd);
-        } else if (g_output_format != OUTPUT_QUIET) {
-            fprintf(stderr, "Error: Unknown command '%s'\n", cmd);
-            print_usage(argv[0]);
-        }
-        ret = 1;
+
+    int ret;
+
+    if (strcmp(argv[1], "--daemon") == 0 || strcmp(argv[1], "daemon") == 0) {
+        ret = run_daemon(conn);
+    } else {
+        ret = run_command(conn, argc, argv);
     }
 
-cleanup:
-    close(fd);
+    dmx_shm_close(g_shm);
+    dmx_close(conn);
     return ret;
 }
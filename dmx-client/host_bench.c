@@ -0,0 +1,384 @@
+/* SPDX-License-Identifier: BSD-3-Clause */
+/*
+ * Copyright (c) 2025 Pierre Jay
+ *
+ * Host-native protocol benchmarks + mock RPMSG endpoint.
+ *
+ * Everything else in this directory cross-compiles for the board, so
+ * protocol changes could only be measured with a flash-and-boot cycle.
+ * This harness builds with the host toolchain (`make host`) instead:
+ * a pty stands in for /dev/ttyRPMSG0, and a mock firmware thread
+ * serves its master side with the same framing rules as the real
+ * parser (v1/v2, NO_ACK, checksums), with optional artificial response
+ * latency to replay board-like round-trip times. The client side goes
+ * through the real libdmx - packet build, write, reassembly, verify -
+ * so protocol v2, batching and parser experiments run on the desk.
+ *
+ * Usage:
+ *   ./dmx_host_bench [rtt_iters] [latency_us]
+ *
+ *   rtt_iters:  round trips per I/O benchmark (default 10000)
+ *   latency_us: simulated firmware response latency (default 0;
+ *               ~250 is representative of the RPMSG link)
+ */
+
+#define _XOPEN_SOURCE 600   /* posix_openpt/grantpt/unlockpt/ptsname */
+#define _DEFAULT_SOURCE     /* usleep */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <errno.h>
+#include <time.h>
+#include <pthread.h>
+
+#include "dmx_protocol.h"
+#include "libdmx.h"
+
+/* ============================================================================
+ * Helpers
+ * ============================================================================ */
+
+static uint64_t now_us(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000ULL + (uint64_t)ts.tv_nsec / 1000ULL;
+}
+
+static int cmp_u32(const void *a, const void *b)
+{
+    uint32_t x = *(const uint32_t *)a, y = *(const uint32_t *)b;
+    return (x > y) - (x < y);
+}
+
+/* ============================================================================
+ * Mock RPMSG Endpoint (pty slave = fake /dev/ttyRPMSG0)
+ * ============================================================================ */
+
+typedef struct {
+    int fd;             /* pty master - the "firmware" side */
+    int latency_us;     /* Artificial delay before each response */
+    unsigned long served;
+} mock_ept_t;
+
+/* Blocking full read on the mock side; <0 on EOF/error (client closed) */
+static int mock_read_exact(int fd, uint8_t *buf, size_t len)
+{
+    size_t got = 0;
+
+    while (got < len) {
+        ssize_t n = read(fd, buf + got, len - got);
+        if (n <= 0) {
+            if (n < 0 && errno == EINTR) {
+                continue;
+            }
+            return -1;
+        }
+        got += (size_t)n;
+    }
+    return 0;
+}
+
+static void mock_write_all(int fd, const uint8_t *buf, size_t len)
+{
+    size_t put = 0;
+
+    while (put < len) {
+        ssize_t n = write(fd, buf + put, len - put);
+        if (n <= 0) {
+            return;
+        }
+        put += (size_t)n;
+    }
+}
+
+/*
+ * Serve commands exactly like parse_command() in the firmware: header
+ * length from the magic byte, checksum verified over the whole packet,
+ * NO_ACK honored, v2 responses echoing seq/universe. Response payloads
+ * are canned (a plausible status for GET_STATUS, empty otherwise) -
+ * the harness measures the transport and parser, not DMX semantics.
+ */
+static void *mock_serve(void *arg)
+{
+    mock_ept_t *m = (mock_ept_t *)arg;
+    uint8_t pkt[DMX_MAX_PAYLOAD];
+    uint8_t resp[DMX_MAX_PAYLOAD];
+
+    for (;;) {
+        if (mock_read_exact(m->fd, pkt, 4) < 0) {
+            break;
+        }
+        int hdr = (pkt[0] == DMX_MAGIC_CMD_V2) ? 6 : 4;
+        if (hdr == 6 && mock_read_exact(m->fd, &pkt[4], 2) < 0) {
+            break;
+        }
+
+        int len = pkt[hdr - 2] | (pkt[hdr - 1] << 8);
+        if (len > (int)sizeof(pkt) - hdr - 1 ||
+            mock_read_exact(m->fd, &pkt[hdr], len + 1) < 0) {
+            break;
+        }
+
+        uint8_t cmd = pkt[1] & DMX_CMD_TYPE_MASK;
+        uint8_t status = dmx_verify_checksum(pkt, hdr + len + 1)
+                             ? STATUS_OK : STATUS_INVALID_CHECKSUM;
+        m->served++;
+
+        if (pkt[1] & DMX_CMD_FLAG_NO_ACK) {
+            continue;
+        }
+        if (m->latency_us > 0) {
+            usleep((useconds_t)m->latency_us);
+        }
+
+        /* Canned response payload */
+        uint8_t payload[64];
+        uint16_t plen = 0;
+        if (status == STATUS_OK && cmd == CMD_DMX_GET_STATUS) {
+            dmx_status_payload_t st = {
+                .enabled = 1, .frame_count = m->served,
+                .fps = 4400, .effective_hz = 44, .throttled = 0, .rsvd = 0,
+            };
+            memcpy(payload, &st, sizeof(st));
+            plen = sizeof(st);
+        }
+
+        int p = 0;
+        if (hdr == 6) {
+            resp[p++] = DMX_MAGIC_RESP_V2;
+            resp[p++] = status;
+            resp[p++] = pkt[2];     /* Echo seq */
+            resp[p++] = pkt[3];     /* Echo universe */
+        } else {
+            resp[p++] = DMX_MAGIC_RESP;
+            resp[p++] = status;
+        }
+        resp[p++] = plen & 0xFF;
+        resp[p++] = (plen >> 8) & 0xFF;
+        memcpy(&resp[p], payload, plen);
+        p += plen;
+        resp[p] = dmx_calc_checksum(resp, p);
+        p++;
+
+        mock_write_all(m->fd, resp, p);
+    }
+    return NULL;
+}
+
+/* Open a pty pair: master goes to the mock thread, the slave path is
+ * what dmx_open() gets instead of /dev/ttyRPMSG0 */
+static int mock_open_pty(char *slave_path, size_t path_size)
+{
+    int mfd = posix_openpt(O_RDWR | O_NOCTTY);
+
+    if (mfd < 0 || grantpt(mfd) < 0 || unlockpt(mfd) < 0) {
+        perror("posix_openpt");
+        return -1;
+    }
+
+    const char *name = ptsname(mfd);
+    if (!name) {
+        close(mfd);
+        return -1;
+    }
+    snprintf(slave_path, path_size, "%s", name);
+    return mfd;
+}
+
+/* ============================================================================
+ * Microbenchmarks (no I/O - pure packet engine)
+ * ============================================================================ */
+
+/*
+ * Packet build throughput. The checksum accumulator keeps the compiler
+ * from dropping the builds; the wire bytes/packet figure includes the
+ * header and checksum the builder adds.
+ */
+static void bench_build(const char *name, int v2, uint16_t channels, long iters)
+{
+    uint8_t payload[2 + DMX_MAX_CHANNELS];
+    uint8_t buf[DMX_MAX_PAYLOAD];
+    uint32_t acc = 0;
+    int len = 0;
+
+    payload[0] = 0;
+    payload[1] = 0;
+    for (int i = 0; i < channels; i++) {
+        payload[2 + i] = (uint8_t)i;
+    }
+
+    uint64_t t0 = now_us();
+    for (long i = 0; i < iters; i++) {
+        if (v2) {
+            len = dmx_build_cmd_packet_v2(buf, CMD_DMX_SET_CHANNELS,
+                                          (uint8_t)i, 1, payload,
+                                          2 + channels);
+        } else {
+            len = dmx_build_cmd_packet(buf, CMD_DMX_SET_CHANNELS,
+                                       payload, 2 + channels);
+        }
+        acc += buf[len - 1];
+    }
+    uint64_t us = now_us() - t0;
+
+    printf("  %-26s %8ld pkts in %7llu µs = %8.0f pkts/s, %7.1f MB/s (acc=%u)\n",
+           name, iters, (unsigned long long)us,
+           iters * 1e6 / (double)us,
+           (double)iters * len / (double)us, acc);
+}
+
+/* Checksum verify throughput over a full-universe packet */
+static void bench_verify(long iters)
+{
+    uint8_t payload[2 + DMX_MAX_CHANNELS] = { 0 };
+    uint8_t buf[DMX_MAX_PAYLOAD];
+    uint32_t acc = 0;
+
+    int len = dmx_build_cmd_packet(buf, CMD_DMX_SET_CHANNELS,
+                                   payload, sizeof(payload));
+
+    uint64_t t0 = now_us();
+    for (long i = 0; i < iters; i++) {
+        acc += (uint32_t)dmx_verify_checksum(buf, len);
+    }
+    uint64_t us = now_us() - t0;
+
+    printf("  %-26s %8ld pkts in %7llu µs = %8.0f pkts/s, %7.1f MB/s (acc=%u)\n",
+           "verify 512ch", iters, (unsigned long long)us,
+           iters * 1e6 / (double)us,
+           (double)iters * len / (double)us, acc);
+}
+
+/* ============================================================================
+ * Replay Harness (round trips through the mock endpoint)
+ * ============================================================================ */
+
+/* Synchronous round trips; per-iteration latency distribution */
+static int bench_rtt(dmx_conn_t *conn, long iters)
+{
+    uint32_t *samples = malloc((size_t)iters * sizeof(*samples));
+    dmx_status_payload_t st;
+
+    if (!samples) {
+        return -1;
+    }
+
+    for (long i = 0; i < iters; i++) {
+        uint64_t t0 = now_us();
+        if (dmx_cmd_get_status(conn, &st) != DMX_OK) {
+            fprintf(stderr, "rtt: round trip %ld failed\n", i);
+            free(samples);
+            return -1;
+        }
+        samples[i] = (uint32_t)(now_us() - t0);
+    }
+
+    qsort(samples, (size_t)iters, sizeof(*samples), cmp_u32);
+    uint64_t sum = 0;
+    for (long i = 0; i < iters; i++) {
+        sum += samples[i];
+    }
+
+    printf("  sync GET_STATUS:  %ld round trips, "
+           "min/p50/p99/max = %u/%u/%u/%u µs, avg %.1f µs\n",
+           iters, samples[0], samples[iters / 2],
+           samples[iters - 1 - iters / 100], samples[iters - 1],
+           (double)sum / (double)iters);
+
+    free(samples);
+    return 0;
+}
+
+/* Pipelined v2 (depth DMX_MAX_INFLIGHT) full-universe writes - the
+ * configuration where simulated latency overlaps instead of summing */
+static int bench_pipeline(dmx_conn_t *conn, long iters)
+{
+    uint8_t payload[2 + DMX_MAX_CHANNELS] = { 0 };
+
+    uint64_t t0 = now_us();
+    long sent = 0, done = 0;
+
+    while (done < iters) {
+        while (sent < iters && dmx_inflight(conn) < DMX_MAX_INFLIGHT) {
+            if (dmx_send_async(conn, CMD_DMX_SET_CHANNELS, payload,
+                               sizeof(payload), NULL) != DMX_OK) {
+                fprintf(stderr, "pipeline: send %ld failed\n", sent);
+                return -1;
+            }
+            sent++;
+        }
+        if (dmx_recv_async(conn, NULL, NULL, 0, NULL) != DMX_OK) {
+            fprintf(stderr, "pipeline: recv %ld failed\n", done);
+            return -1;
+        }
+        done++;
+    }
+    uint64_t us = now_us() - t0;
+
+    printf("  v2 pipeline x%-3d  %ld x 512ch writes in %llu µs = %.0f cmds/s\n",
+           DMX_MAX_INFLIGHT, iters, (unsigned long long)us,
+           iters * 1e6 / (double)us);
+    return 0;
+}
+
+/* ============================================================================
+ * Main
+ * ============================================================================ */
+
+int main(int argc, char *argv[])
+{
+    long iters = (argc >= 2) ? atol(argv[1]) : 10000;
+    int latency_us = (argc >= 3) ? atoi(argv[2]) : 0;
+
+    if (iters < 1 || latency_us < 0) {
+        fprintf(stderr, "Usage: %s [rtt_iters] [latency_us]\n", argv[0]);
+        return 1;
+    }
+
+    printf("Packet engine (host CPU, no I/O):\n");
+    bench_build("build 8ch v1", 0, 8, 1000000);
+    bench_build("build 512ch v1", 0, 512, 200000);
+    bench_build("build 512ch v2", 1, 512, 200000);
+    bench_verify(200000);
+
+    char slave_path[64];
+    mock_ept_t mock = { .latency_us = latency_us };
+    pthread_t tid;
+
+    mock.fd = mock_open_pty(slave_path, sizeof(slave_path));
+    if (mock.fd < 0) {
+        return 1;
+    }
+    if (pthread_create(&tid, NULL, mock_serve, &mock) != 0) {
+        perror("pthread_create");
+        return 1;
+    }
+
+    printf("\nMock endpoint on %s (response latency %d µs):\n",
+           slave_path, latency_us);
+
+    dmx_conn_t *conn = dmx_open(slave_path);
+    if (!conn) {
+        perror("dmx_open");
+        return 1;
+    }
+
+    int ret = 0;
+    if (bench_rtt(conn, iters) < 0) {
+        ret = 1;
+    }
+    if (ret == 0 && bench_pipeline(conn, iters) < 0) {
+        ret = 1;
+    }
+
+    dmx_close(conn);            /* EOF stops the mock thread */
+    pthread_join(tid, NULL);
+    close(mock.fd);
+
+    return ret;
+}
@@ -0,0 +1,1113 @@
+/* SPDX-License-Identifier: BSD-3-Clause */
+/*
+ * Copyright (c) 2025 Pierre Jay
+ *
+ * libdmx - DMX512 RPMSG client library implementation.
+ *
+ * The packet engine (build/send/receive/verify) lives here; the CLI in
+ * dmx_client.c and the gateway (via cgo) are both thin users of this API.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <errno.h>
+#include <sys/select.h>
+#include <sys/ioctl.h>
+#include <sys/mman.h>
+#include <termios.h>
+#include "libdmx.h"
+
+#define DMX_DEFAULT_DEVICE   "/dev/ttyRPMSG0"
+#define DMX_RAW_DEFAULT_CTRL "/dev/rpmsg_ctrl0"
+#define DMX_DEFAULT_TIMEOUT  1000           /* Response timeout (ms) */
+
+/*
+ * rpmsg_char endpoint creation (from <linux/rpmsg.h>, defined locally
+ * so the library builds against older kernel headers too)
+ */
+struct dmx_rpmsg_ept_info {
+    char name[32];
+    uint32_t src;
+    uint32_t dst;
+};
+#define DMX_RPMSG_CREATE_EPT_IOCTL  _IOW(0xb5, 0x1, struct dmx_rpmsg_ept_info)
+#define DMX_RPMSG_DESTROY_EPT_IOCTL _IO(0xb5, 0x2)
+#define DMX_RPMSG_ADDR_ANY          0xFFFFFFFFu
+
+/* ============================================================================
+ * Connection Handle
+ * ============================================================================ */
+
+struct dmx_conn {
+    int fd;                 /* Open RPMSG device */
+    int timeout_ms;         /* Response timeout */
+    int no_ack;             /* Fire-and-forget mode for write commands */
+    int inflight;           /* Outstanding v2 commands (async API) */
+    int datagram;           /* rpmsg_char endpoint: 1 read = 1 packet */
+    int ept_created;        /* We created the endpoint (destroy on close) */
+    uint8_t next_seq;       /* Next v2 sequence tag (wraps at 255) */
+    uint8_t universe;       /* Target universe (0 = v1 framing) */
+    uint8_t last_status;    /* Firmware status byte of last round trip */
+};
+
+/*
+ * Write-type commands may be sent fire-and-forget (DMX_CMD_FLAG_NO_ACK)
+ */
+static int cmd_is_write(uint8_t cmd)
+{
+    switch (cmd) {
+        case CMD_DMX_SET_CHANNELS:
+        case CMD_DMX_SET_SPARSE:
+        case CMD_DMX_ENABLE:
+        case CMD_DMX_DISABLE:
+        case CMD_DMX_BLACKOUT:
+        case CMD_DMX_SET_TIMING:
+        case CMD_DMX_FADE:
+        case CMD_DMX_STAGE:
+        case CMD_DMX_COMMIT:
+        case CMD_DMX_SCENE_STORE:
+        case CMD_DMX_SCENE_RECALL:
+            return 1;
+        default:
+            return 0;
+    }
+}
+
+/* ============================================================================
+ * Internal Helpers
+ * ============================================================================ */
+
+/*
+ * Wait for data with timeout using select()
+ * Returns: 1 if data available, 0 on timeout, -1 on error
+ */
+static int wait_for_data(int fd, int timeout_ms)
+{
+    fd_set read_fds;
+    struct timeval tv;
+
+    FD_ZERO(&read_fds);
+    FD_SET(fd, &read_fds);
+
+    tv.tv_sec = timeout_ms / 1000;
+    tv.tv_usec = (timeout_ms % 1000) * 1000;
+
+    return select(fd + 1, &read_fds, NULL, NULL, &tv);
+}
+
+/*
+ * Configure TTY for raw binary mode
+ * Essential for binary protocols - prevents control char interpretation
+ */
+static int configure_tty_raw(int fd)
+{
+    struct termios tty;
+    if (tcgetattr(fd, &tty) < 0) return -1;
+
+    cfmakeraw(&tty);
+
+    /* VMIN=1: read() blocks until at least 1 byte available */
+    tty.c_cc[VMIN] = 1;
+    tty.c_cc[VTIME] = 0;
+
+    if (tcsetattr(fd, TCSANOW, &tty) < 0) return -1;
+    return 0;
+}
+
+/*
+ * Read exactly 'count' bytes via polling loop
+ * Returns: number of bytes read (should equal count), or -1 on error/timeout
+ */
+static int read_exact(int fd, uint8_t *buf, int count, int timeout_ms)
+{
+    int total_read = 0;
+    while (total_read < count) {
+        int sel_ret = wait_for_data(fd, timeout_ms);
+        if (sel_ret <= 0) return -1;  /* Timeout or error */
+
+        int n = read(fd, buf + total_read, count - total_read);
+        if (n < 0) return -1;
+        if (n == 0) return total_read;  /* Unexpected EOF */
+
+        total_read += n;
+    }
+    return total_read;
+}
+
+/*
+ * Receive one complete firmware packet into pkt (contiguous)
+ *
+ * The header length follows from the magic byte: v1 responses and
+ * pushed events carry the payload length at bytes 2-3, v2 responses at
+ * 4-5. Framing it off the wire (instead of off the caller's
+ * expectation) keeps the stream in sync when an unsolicited event
+ * arrives while a response reader is waiting. On a tty transport the
+ * packet arrives as a byte stream and is reassembled with
+ * read_exact(); on an rpmsg_char endpoint each read() returns one
+ * whole rpmsg message, so a single read is the whole packet.
+ *
+ * Returns: total packet length (header + payload + checksum), or -1 on
+ *          timeout/error/truncation
+ */
+static int recv_packet(dmx_conn_t *conn, uint8_t *pkt, int pkt_size)
+{
+    if (conn->datagram) {
+        if (wait_for_data(conn->fd, conn->timeout_ms) <= 0) {
+            return -1;
+        }
+        int n = read(conn->fd, pkt, pkt_size);
+        return (n >= 5) ? n : -1;
+    }
+
+    if (read_exact(conn->fd, pkt, 4, conn->timeout_ms) < 4) {
+        return -1;
+    }
+
+    int hdr_len = (pkt[0] == DMX_MAGIC_RESP_V2) ? 6 : 4;
+    if (hdr_len == 6 &&
+        read_exact(conn->fd, &pkt[4], 2, conn->timeout_ms) < 2) {
+        return -1;
+    }
+
+    int data_len = pkt[hdr_len - 2] | (pkt[hdr_len - 1] << 8);
+    if (hdr_len + data_len + 1 > pkt_size) {
+        return -1;
+    }
+    if (read_exact(conn->fd, &pkt[hdr_len], data_len + 1,
+                   conn->timeout_ms) != data_len + 1) {
+        return -1;
+    }
+    return hdr_len + data_len + 1;
+}
+
+/* ============================================================================
+ * Low-level API (packet engine)
+ * ============================================================================ */
+
+int dmx_build_cmd_packet(uint8_t *buf, uint8_t cmd, const uint8_t *payload, uint16_t payload_len)
+{
+    buf[0] = DMX_MAGIC_CMD;
+    buf[1] = cmd;
+    buf[2] = payload_len & 0xFF;         /* Little-endian length */
+    buf[3] = (payload_len >> 8) & 0xFF;
+
+    if (payload_len > 0) {
+        memcpy(&buf[4], payload, payload_len);
+    }
+
+    /* Calculate checksum (entire packet except checksum byte) */
+    uint8_t checksum = dmx_calc_checksum(buf, 4 + payload_len);
+    buf[4 + payload_len] = checksum;
+
+    return 4 + payload_len + 1;  /* header + payload + checksum */
+}
+
+static int send_cmd_v2_sync(dmx_conn_t *conn, uint8_t cmd,
+                            const uint8_t *payload, uint16_t payload_len,
+                            uint8_t *resp_buf, uint16_t resp_buf_size, uint16_t *resp_len);
+
+int dmx_send_cmd(dmx_conn_t *conn, uint8_t cmd, const uint8_t *payload, uint16_t payload_len,
+                 uint8_t *resp_buf, uint16_t resp_buf_size, uint16_t *resp_len)
+{
+    uint8_t tx_buf[DMX_MAX_PAYLOAD];
+
+    if (!conn || payload_len > DMX_MAX_PAYLOAD - 5) {
+        return DMX_ERR_ARG;
+    }
+
+    /* v1 framing can't carry a universe - route non-zero universes
+     * through v2 (same blocking semantics, 2 extra header bytes).
+     * CMD_DMX_BATCH keeps v1 framing and only addresses universe 0. */
+    if (conn->universe != 0 && cmd != CMD_DMX_BATCH) {
+        return send_cmd_v2_sync(conn, cmd, payload, payload_len,
+                                resp_buf, resp_buf_size, resp_len);
+    }
+
+    /* Fire-and-forget: set the flag before building (it is checksummed) */
+    int skip_resp = conn->no_ack && cmd_is_write(cmd);
+    uint8_t wire_cmd = skip_resp ? (cmd | DMX_CMD_FLAG_NO_ACK) : cmd;
+
+    int tx_len = dmx_build_cmd_packet(tx_buf, wire_cmd, payload, payload_len);
+
+    /* Send command */
+    if (write(conn->fd, tx_buf, tx_len) != tx_len) {
+        return DMX_ERR_IO;
+    }
+
+    /* No response expected for fire-and-forget commands */
+    if (skip_resp) {
+        if (resp_len) {
+            *resp_len = 0;
+        }
+        return DMX_OK;
+    }
+
+    /* Receive the response packet (one datagram, or reassembled),
+     * discarding any pushed events that interleave with it */
+    uint8_t pkt[DMX_MAX_PAYLOAD];
+    int total;
+    do {
+        total = recv_packet(conn, pkt, sizeof(pkt));
+        if (total < 0) {
+            return DMX_ERR_TIMEOUT;
+        }
+    } while (pkt[0] == DMX_MAGIC_EVENT);
+
+    /* Verify magic */
+    if (pkt[0] != DMX_MAGIC_RESP) {
+        return DMX_ERR_PROTOCOL;
+    }
+
+    uint8_t status = pkt[1];
+    uint16_t data_len = pkt[2] | (pkt[3] << 8);
+
+    if (total != 4 + data_len + 1 || data_len > resp_buf_size) {
+        return DMX_ERR_PROTOCOL;
+    }
+    if (!dmx_verify_checksum(pkt, total)) {
+        return DMX_ERR_PROTOCOL;
+    }
+
+    if (data_len > 0) {
+        memcpy(resp_buf, &pkt[4], data_len);
+    }
+
+    /* Check status */
+    conn->last_status = status;
+    if (status != STATUS_OK) {
+        return DMX_ERR_STATUS;
+    }
+
+    if (resp_len) {
+        *resp_len = data_len;
+    }
+    return DMX_OK;
+}
+
+int dmx_build_cmd_packet_v2(uint8_t *buf, uint8_t cmd, uint8_t seq, uint8_t universe,
+                            const uint8_t *payload, uint16_t payload_len)
+{
+    buf[0] = DMX_MAGIC_CMD_V2;
+    buf[1] = cmd;
+    buf[2] = seq;
+    buf[3] = universe;
+    buf[4] = payload_len & 0xFF;         /* Little-endian length */
+    buf[5] = (payload_len >> 8) & 0xFF;
+
+    if (payload_len > 0) {
+        memcpy(&buf[6], payload, payload_len);
+    }
+
+    uint8_t checksum = dmx_calc_checksum(buf, 6 + payload_len);
+    buf[6 + payload_len] = checksum;
+
+    return 6 + payload_len + 1;  /* header + payload + checksum */
+}
+
+/*
+ * Synchronous round trip over v2 framing - used by dmx_send_cmd() when a
+ * non-zero universe is selected. Same semantics as the v1 path: one
+ * command, block for the matching response (tag verified).
+ */
+static int send_cmd_v2_sync(dmx_conn_t *conn, uint8_t cmd,
+                            const uint8_t *payload, uint16_t payload_len,
+                            uint8_t *resp_buf, uint16_t resp_buf_size, uint16_t *resp_len)
+{
+    uint8_t tx_buf[DMX_MAX_PAYLOAD];
+
+    if (payload_len > DMX_MAX_PAYLOAD - 7) {
+        return DMX_ERR_ARG;
+    }
+
+    /* Fire-and-forget: set the flag before building (it is checksummed) */
+    int skip_resp = conn->no_ack && cmd_is_write(cmd);
+    uint8_t wire_cmd = skip_resp ? (cmd | DMX_CMD_FLAG_NO_ACK) : cmd;
+
+    uint8_t seq = conn->next_seq++;
+    int tx_len = dmx_build_cmd_packet_v2(tx_buf, wire_cmd, seq, conn->universe,
+                                         payload, payload_len);
+
+    if (write(conn->fd, tx_buf, tx_len) != tx_len) {
+        return DMX_ERR_IO;
+    }
+
+    if (skip_resp) {
+        if (resp_len) {
+            *resp_len = 0;
+        }
+        return DMX_OK;
+    }
+
+    /* Receive the v2 response packet (one datagram, or reassembled),
+     * discarding any pushed events that interleave with it */
+    uint8_t pkt[DMX_MAX_PAYLOAD];
+    int total;
+    do {
+        total = recv_packet(conn, pkt, sizeof(pkt));
+        if (total < 0) {
+            return DMX_ERR_TIMEOUT;
+        }
+    } while (pkt[0] == DMX_MAGIC_EVENT);
+
+    if (pkt[0] != DMX_MAGIC_RESP_V2 || pkt[2] != seq) {
+        return DMX_ERR_PROTOCOL;
+    }
+
+    uint8_t status = pkt[1];
+    uint16_t data_len = pkt[4] | (pkt[5] << 8);
+
+    if (total != 6 + data_len + 1 || data_len > resp_buf_size) {
+        return DMX_ERR_PROTOCOL;
+    }
+    if (dmx_calc_checksum(pkt, 6 + data_len) != pkt[6 + data_len]) {
+        return DMX_ERR_PROTOCOL;
+    }
+
+    if (data_len > 0) {
+        memcpy(resp_buf, &pkt[6], data_len);
+    }
+
+    conn->last_status = status;
+    if (status != STATUS_OK) {
+        return DMX_ERR_STATUS;
+    }
+
+    if (resp_len) {
+        *resp_len = data_len;
+    }
+    return DMX_OK;
+}
+
+/* ============================================================================
+ * Async API (protocol v2, pipelined)
+ * ============================================================================ */
+
+int dmx_send_async(dmx_conn_t *conn, uint8_t cmd,
+                   const uint8_t *payload, uint16_t payload_len, uint8_t *tag_out)
+{
+    uint8_t tx_buf[DMX_MAX_PAYLOAD];
+
+    if (!conn || payload_len > DMX_MAX_PAYLOAD - 7 || cmd == CMD_DMX_BATCH) {
+        return DMX_ERR_ARG;
+    }
+    if (conn->inflight >= DMX_MAX_INFLIGHT) {
+        return DMX_ERR_BUSY;
+    }
+
+    uint8_t seq = conn->next_seq++;
+    int tx_len = dmx_build_cmd_packet_v2(tx_buf, cmd, seq, conn->universe,
+                                         payload, payload_len);
+
+    if (write(conn->fd, tx_buf, tx_len) != tx_len) {
+        return DMX_ERR_IO;
+    }
+
+    conn->inflight++;
+    if (tag_out) {
+        *tag_out = seq;
+    }
+    return DMX_OK;
+}
+
+int dmx_recv_async(dmx_conn_t *conn, uint8_t *tag_out,
+                   uint8_t *resp_buf, uint16_t resp_buf_size, uint16_t *resp_len)
+{
+    if (!conn || conn->inflight == 0) {
+        return DMX_ERR_ARG;
+    }
+
+    /* Receive the v2 response packet (one datagram, or reassembled),
+     * discarding any pushed events that interleave with it */
+    uint8_t pkt[DMX_MAX_PAYLOAD];
+    int total;
+    do {
+        total = recv_packet(conn, pkt, sizeof(pkt));
+        if (total < 0) {
+            return DMX_ERR_TIMEOUT;
+        }
+    } while (pkt[0] == DMX_MAGIC_EVENT);
+
+    if (pkt[0] != DMX_MAGIC_RESP_V2) {
+        return DMX_ERR_PROTOCOL;
+    }
+
+    uint8_t status = pkt[1];
+    uint8_t seq = pkt[2];
+    uint16_t data_len = pkt[4] | (pkt[5] << 8);
+
+    if (total != 6 + data_len + 1 || data_len > resp_buf_size) {
+        return DMX_ERR_PROTOCOL;
+    }
+    if (dmx_calc_checksum(pkt, 6 + data_len) != pkt[6 + data_len]) {
+        return DMX_ERR_PROTOCOL;
+    }
+
+    if (data_len > 0) {
+        memcpy(resp_buf, &pkt[6], data_len);
+    }
+
+    /* One response consumed, whatever its status */
+    conn->inflight--;
+    conn->last_status = status;
+    if (tag_out) {
+        *tag_out = seq;
+    }
+    if (resp_len) {
+        *resp_len = data_len;
+    }
+
+    return (status == STATUS_OK) ? DMX_OK : DMX_ERR_STATUS;
+}
+
+int dmx_inflight(const dmx_conn_t *conn)
+{
+    return conn ? conn->inflight : 0;
+}
+
+/* ============================================================================
+ * Shared-Memory Universe Mirror (seqlock writer)
+ * ============================================================================ */
+
+struct dmx_shm {
+    int fd;                              /* /dev/mem */
+    volatile dmx_shm_universe_t *map;    /* Mapped mirror */
+    size_t map_len;                      /* Mapping length (page-rounded) */
+};
+
+dmx_shm_t *dmx_shm_open(void)
+{
+    dmx_shm_t *shm = calloc(1, sizeof(*shm));
+    if (!shm) {
+        return NULL;
+    }
+
+    shm->fd = open("/dev/mem", O_RDWR | O_SYNC);
+    if (shm->fd < 0) {
+        free(shm);
+        return NULL;
+    }
+
+    /* DMX_SHM_PHYS_ADDR is 64KB-aligned; round the length up to a page */
+    long page = sysconf(_SC_PAGESIZE);
+    shm->map_len = ((sizeof(dmx_shm_universe_t) + page - 1) / page) * page;
+
+    shm->map = mmap(NULL, shm->map_len, PROT_READ | PROT_WRITE,
+                    MAP_SHARED, shm->fd, DMX_SHM_PHYS_ADDR);
+    if (shm->map == MAP_FAILED) {
+        close(shm->fd);
+        free(shm);
+        return NULL;
+    }
+
+    return shm;
+}
+
+void dmx_shm_close(dmx_shm_t *shm)
+{
+    if (!shm) {
+        return;
+    }
+    munmap((void *)shm->map, shm->map_len);
+    close(shm->fd);
+    free(shm);
+}
+
+int dmx_shm_ready(const dmx_shm_t *shm)
+{
+    return (shm && shm->map->magic == DMX_SHM_MAGIC) ? 1 : 0;
+}
+
+int dmx_shm_publish(dmx_shm_t *shm, uint16_t start,
+                    const uint8_t *values, uint16_t count)
+{
+    if (!shm || !values || count == 0 || start + count > DMX_MAX_CHANNELS) {
+        return DMX_ERR_ARG;
+    }
+    if (shm->map->magic != DMX_SHM_MAGIC) {
+        return DMX_ERR_PROTOCOL;
+    }
+
+    /* Seqlock write: odd = in progress, even = stable */
+    uint32_t seq = shm->map->seq;
+    shm->map->seq = seq + 1;
+    __sync_synchronize();
+
+    memcpy((void *)&shm->map->channels[start], values, count);
+
+    __sync_synchronize();
+    shm->map->seq = seq + 2;
+    shm->map->publish_count++;
+
+    return DMX_OK;
+}
+
+/* ============================================================================
+ * Connection Handling
+ * ============================================================================ */
+
+dmx_conn_t *dmx_open(const char *device)
+{
+    if (!device) {
+        device = DMX_DEFAULT_DEVICE;
+    }
+
+    dmx_conn_t *conn = calloc(1, sizeof(*conn));
+    if (!conn) {
+        return NULL;
+    }
+
+    conn->fd = open(device, O_RDWR | O_NOCTTY);
+    if (conn->fd < 0) {
+        free(conn);
+        return NULL;
+    }
+
+    if (configure_tty_raw(conn->fd) < 0) {
+        close(conn->fd);
+        free(conn);
+        return NULL;
+    }
+
+    conn->timeout_ms = DMX_DEFAULT_TIMEOUT;
+    conn->last_status = STATUS_OK;
+    return conn;
+}
+
+/* Bitmap of the /dev/rpmsgN endpoint devices that currently exist */
+static uint64_t raw_scan_eptdevs(void)
+{
+    uint64_t mask = 0;
+    char path[32];
+
+    for (int i = 0; i < 64; i++) {
+        snprintf(path, sizeof(path), "/dev/rpmsg%d", i);
+        if (access(path, F_OK) == 0) {
+            mask |= 1ull << i;
+        }
+    }
+    return mask;
+}
+
+dmx_conn_t *dmx_open_raw(const char *device)
+{
+    if (!device) {
+        device = DMX_RAW_DEFAULT_CTRL;
+    }
+
+    dmx_conn_t *conn = calloc(1, sizeof(*conn));
+    if (!conn) {
+        return NULL;
+    }
+    conn->fd = -1;
+
+    if (strstr(device, "rpmsg_ctrl")) {
+        /*
+         * Control device: create an endpoint bound to the firmware's
+         * raw address, then open the /dev/rpmsgN node the kernel
+         * registers for it. The node is found by diffing the device
+         * list around the ioctl (endpoint devices carry no name
+         * attribute to match on).
+         */
+        int ctrl_fd = open(device, O_RDWR);
+        if (ctrl_fd < 0) {
+            free(conn);
+            return NULL;
+        }
+
+        uint64_t before = raw_scan_eptdevs();
+
+        struct dmx_rpmsg_ept_info info;
+        memset(&info, 0, sizeof(info));
+        snprintf(info.name, sizeof(info.name), "%s", DMX_RAW_EPT_NAME);
+        info.src = DMX_RPMSG_ADDR_ANY;
+        info.dst = DMX_RAW_EPT_ADDR;
+
+        if (ioctl(ctrl_fd, DMX_RPMSG_CREATE_EPT_IOCTL, &info) < 0) {
+            close(ctrl_fd);
+            free(conn);
+            return NULL;
+        }
+        close(ctrl_fd);
+
+        /* The node appears asynchronously (udev) - poll briefly */
+        for (int retry = 0; retry < 50 && conn->fd < 0; retry++) {
+            uint64_t fresh = raw_scan_eptdevs() & ~before;
+            if (fresh) {
+                char path[32];
+                int idx = __builtin_ctzll(fresh);
+                snprintf(path, sizeof(path), "/dev/rpmsg%d", idx);
+                conn->fd = open(path, O_RDWR);
+                break;
+            }
+            usleep(10000);
+        }
+        if (conn->fd < 0) {
+            free(conn);
+            return NULL;
+        }
+        conn->ept_created = 1;
+    } else {
+        /* Pre-created endpoint node (udev rule or earlier ioctl) */
+        conn->fd = open(device, O_RDWR);
+        if (conn->fd < 0) {
+            free(conn);
+            return NULL;
+        }
+    }
+
+    /* No tty in the path: nothing to configure, reads are per-message */
+    conn->datagram = 1;
+    conn->timeout_ms = DMX_DEFAULT_TIMEOUT;
+    conn->last_status = STATUS_OK;
+    return conn;
+}
+
+void dmx_close(dmx_conn_t *conn)
+{
+    if (!conn) {
+        return;
+    }
+    if (conn->ept_created) {
+        /* Tear the kernel endpoint down with the connection */
+        ioctl(conn->fd, DMX_RPMSG_DESTROY_EPT_IOCTL);
+    }
+    close(conn->fd);
+    free(conn);
+}
+
+int dmx_fd(const dmx_conn_t *conn)
+{
+    return conn ? conn->fd : -1;
+}
+
+void dmx_set_timeout(dmx_conn_t *conn, int timeout_ms)
+{
+    if (conn && timeout_ms > 0) {
+        conn->timeout_ms = timeout_ms;
+    }
+}
+
+void dmx_set_no_ack(dmx_conn_t *conn, int enable)
+{
+    if (conn) {
+        conn->no_ack = enable;
+    }
+}
+
+void dmx_set_universe(dmx_conn_t *conn, uint8_t universe)
+{
+    if (conn) {
+        conn->universe = universe;
+    }
+}
+
+uint8_t dmx_last_status(const dmx_conn_t *conn)
+{
+    return conn ? conn->last_status : STATUS_ERROR;
+}
+
+const char *dmx_error_string(int err)
+{
+    switch (err) {
+        case DMX_OK:            return "Success";
+        case DMX_ERR_IO:        return "I/O error";
+        case DMX_ERR_TIMEOUT:   return "Timeout waiting for response";
+        case DMX_ERR_PROTOCOL:  return "Protocol error (bad magic, checksum or size)";
+        case DMX_ERR_STATUS:    return "Command rejected by firmware";
+        case DMX_ERR_ARG:       return "Invalid argument";
+        case DMX_ERR_BUSY:      return "Too many commands in flight";
+        default:                return "Unknown error";
+    }
+}
+
+/* ============================================================================
+ * Commands
+ * ============================================================================ */
+
+int dmx_cmd_enable(dmx_conn_t *conn)
+{
+    return dmx_send_cmd(conn, CMD_DMX_ENABLE, NULL, 0, NULL, 0, NULL);
+}
+
+int dmx_cmd_disable(dmx_conn_t *conn)
+{
+    return dmx_send_cmd(conn, CMD_DMX_DISABLE, NULL, 0, NULL, 0, NULL);
+}
+
+int dmx_cmd_blackout(dmx_conn_t *conn)
+{
+    return dmx_send_cmd(conn, CMD_DMX_BLACKOUT, NULL, 0, NULL, 0, NULL);
+}
+
+int dmx_cmd_set_channels(dmx_conn_t *conn, uint16_t start, const uint8_t *values, uint16_t count)
+{
+    if (!values || count == 0 || start + count > DMX_MAX_CHANNELS) {
+        return DMX_ERR_ARG;
+    }
+
+    uint8_t payload[2 + DMX_MAX_CHANNELS];
+    payload[0] = start & 0xFF;
+    payload[1] = (start >> 8) & 0xFF;
+    memcpy(&payload[2], values, count);
+
+    return dmx_send_cmd(conn, CMD_DMX_SET_CHANNELS, payload, 2 + count, NULL, 0, NULL);
+}
+
+int dmx_cmd_set_sparse(dmx_conn_t *conn, const uint16_t *channels,
+                       const uint8_t *values, uint16_t count)
+{
+    if (!channels || !values || count == 0 ||
+        (uint32_t)count * 3 > DMX_MAX_PAYLOAD - 5) {
+        return DMX_ERR_ARG;
+    }
+
+    uint8_t payload[DMX_MAX_PAYLOAD];
+    for (uint16_t i = 0; i < count; i++) {
+        if (channels[i] >= DMX_MAX_CHANNELS) {
+            return DMX_ERR_ARG;
+        }
+        payload[i * 3]     = channels[i] & 0xFF;
+        payload[i * 3 + 1] = (channels[i] >> 8) & 0xFF;
+        payload[i * 3 + 2] = values[i];
+    }
+
+    return dmx_send_cmd(conn, CMD_DMX_SET_SPARSE, payload, count * 3, NULL, 0, NULL);
+}
+
+int dmx_cmd_stage(dmx_conn_t *conn, uint16_t start, const uint8_t *values, uint16_t count)
+{
+    if (!values || count == 0 || start + count > DMX_MAX_CHANNELS) {
+        return DMX_ERR_ARG;
+    }
+
+    uint8_t payload[2 + DMX_MAX_CHANNELS];
+    payload[0] = start & 0xFF;
+    payload[1] = (start >> 8) & 0xFF;
+    memcpy(&payload[2], values, count);
+
+    return dmx_send_cmd(conn, CMD_DMX_STAGE, payload, 2 + count, NULL, 0, NULL);
+}
+
+int dmx_cmd_commit(dmx_conn_t *conn)
+{
+    return dmx_send_cmd(conn, CMD_DMX_COMMIT, NULL, 0, NULL, 0, NULL);
+}
+
+int dmx_cmd_fade(dmx_conn_t *conn, uint16_t start, const uint8_t *targets,
+                 uint16_t count, uint16_t duration_ms, uint8_t easing)
+{
+    if (!targets || count == 0 || start + count > DMX_MAX_CHANNELS ||
+        duration_ms > DMX_FADE_MAX_MS || easing > DMX_FADE_EASE) {
+        return DMX_ERR_ARG;
+    }
+
+    uint8_t payload[sizeof(dmx_fade_t) + DMX_MAX_CHANNELS];
+    dmx_fade_t *fade = (dmx_fade_t *)payload;
+    fade->channel_start = start;
+    fade->duration_ms = duration_ms;
+    fade->easing = easing;
+    memcpy(fade->targets, targets, count);
+
+    return dmx_send_cmd(conn, CMD_DMX_FADE, payload, sizeof(dmx_fade_t) + count,
+                        NULL, 0, NULL);
+}
+
+int dmx_cmd_get_status(dmx_conn_t *conn, dmx_status_payload_t *status)
+{
+    uint8_t resp_buf[sizeof(dmx_status_payload_t)];
+    uint16_t resp_len;
+
+    int ret = dmx_send_cmd(conn, CMD_DMX_GET_STATUS, NULL, 0,
+                           resp_buf, sizeof(resp_buf), &resp_len);
+    if (ret != DMX_OK) {
+        return ret;
+    }
+    if (resp_len != sizeof(dmx_status_payload_t)) {
+        return DMX_ERR_PROTOCOL;
+    }
+
+    if (status) {
+        memcpy(status, resp_buf, sizeof(*status));
+    }
+    return DMX_OK;
+}
+
+int dmx_cmd_get_stats(dmx_conn_t *conn, dmx_stats_payload_t *stats)
+{
+    uint8_t resp_buf[sizeof(dmx_stats_payload_t)];
+    uint16_t resp_len;
+
+    int ret = dmx_send_cmd(conn, CMD_DMX_GET_STATS, NULL, 0,
+                           resp_buf, sizeof(resp_buf), &resp_len);
+    if (ret != DMX_OK) {
+        return ret;
+    }
+    if (resp_len != sizeof(dmx_stats_payload_t)) {
+        return DMX_ERR_PROTOCOL;
+    }
+
+    if (stats) {
+        memcpy(stats, resp_buf, sizeof(*stats));
+    }
+    return DMX_OK;
+}
+
+int dmx_cmd_get_universe(dmx_conn_t *conn, dmx_universe_state_t *state)
+{
+    uint8_t resp_buf[sizeof(dmx_universe_payload_t) + DMX_UNIVERSE_CHUNK_MAX];
+    uint16_t resp_len;
+    uint16_t offset = 0;
+
+    if (!state) {
+        return DMX_ERR_ARG;
+    }
+    memset(state, 0, sizeof(*state));
+
+    while (offset < DMX_MAX_CHANNELS) {
+        uint16_t want = DMX_MAX_CHANNELS - offset;
+        if (want > DMX_UNIVERSE_CHUNK_MAX) {
+            want = DMX_UNIVERSE_CHUNK_MAX;
+        }
+
+        uint8_t payload[4];
+        payload[0] = offset & 0xFF;
+        payload[1] = (offset >> 8) & 0xFF;
+        payload[2] = want & 0xFF;
+        payload[3] = (want >> 8) & 0xFF;
+
+        int ret = dmx_send_cmd(conn, CMD_DMX_GET_UNIVERSE, payload,
+                               sizeof(payload), resp_buf, sizeof(resp_buf),
+                               &resp_len);
+        if (ret != DMX_OK) {
+            return ret;
+        }
+
+        const dmx_universe_payload_t *chunk =
+            (const dmx_universe_payload_t *)resp_buf;
+        if (resp_len < sizeof(dmx_universe_payload_t) ||
+            resp_len != sizeof(dmx_universe_payload_t) + chunk->count ||
+            chunk->offset != offset || chunk->count == 0 ||
+            chunk->offset + chunk->count > DMX_MAX_CHANNELS) {
+            return DMX_ERR_PROTOCOL;
+        }
+
+        /* Config header repeats in every chunk - last writer wins */
+        state->enabled = chunk->enabled;
+        state->refresh_hz = chunk->refresh_hz;
+        state->break_us = chunk->break_us;
+        state->mab_us = chunk->mab_us;
+        state->slots = chunk->slots;
+
+        memcpy(&state->channels[offset], chunk->channels, chunk->count);
+        offset += chunk->count;
+    }
+
+    return DMX_OK;
+}
+
+int dmx_cmd_scene_store(dmx_conn_t *conn, uint8_t scene)
+{
+    if (scene >= DMX_SCENE_COUNT) {
+        return DMX_ERR_ARG;
+    }
+
+    uint8_t payload[1] = { scene };
+
+    return dmx_send_cmd(conn, CMD_DMX_SCENE_STORE, payload, sizeof(payload),
+                        NULL, 0, NULL);
+}
+
+int dmx_cmd_scene_recall(dmx_conn_t *conn, uint8_t scene, uint16_t duration_ms,
+                         uint8_t easing)
+{
+    if (scene >= DMX_SCENE_COUNT || duration_ms > DMX_FADE_MAX_MS ||
+        easing > DMX_FADE_EASE) {
+        return DMX_ERR_ARG;
+    }
+
+    /* Short form for an instant recall, long form for a crossfade */
+    uint8_t payload[4];
+    uint16_t len = 1;
+    payload[0] = scene;
+    if (duration_ms > 0) {
+        payload[1] = duration_ms & 0xFF;
+        payload[2] = (duration_ms >> 8) & 0xFF;
+        payload[3] = easing;
+        len = 4;
+    }
+
+    return dmx_send_cmd(conn, CMD_DMX_SCENE_RECALL, payload, len,
+                        NULL, 0, NULL);
+}
+
+int dmx_cmd_capture_start(dmx_conn_t *conn, uint16_t frames)
+{
+    uint8_t payload[3];
+
+    payload[0] = DMX_CAPTURE_OP_START;
+    payload[1] = frames & 0xFF;
+    payload[2] = (frames >> 8) & 0xFF;
+
+    return dmx_send_cmd(conn, CMD_DMX_CAPTURE, payload, sizeof(payload),
+                        NULL, 0, NULL);
+}
+
+int dmx_cmd_capture_report(dmx_conn_t *conn, dmx_capture_payload_t *report)
+{
+    uint8_t payload[1] = { DMX_CAPTURE_OP_REPORT };
+    uint8_t resp_buf[sizeof(dmx_capture_payload_t)];
+    uint16_t resp_len;
+
+    int ret = dmx_send_cmd(conn, CMD_DMX_CAPTURE, payload, sizeof(payload),
+                           resp_buf, sizeof(resp_buf), &resp_len);
+    if (ret != DMX_OK) {
+        return ret;
+    }
+    if (resp_len != sizeof(dmx_capture_payload_t)) {
+        return DMX_ERR_PROTOCOL;
+    }
+
+    if (report) {
+        memcpy(report, resp_buf, sizeof(*report));
+    }
+    return DMX_OK;
+}
+
+int dmx_cmd_set_timing(dmx_conn_t *conn, uint16_t refresh_hz, uint16_t break_us,
+                       uint16_t mab_us, uint16_t slots)
+{
+    dmx_timing_t timing;
+    timing.refresh_hz = refresh_hz;
+    timing.break_us = break_us;
+    timing.mab_us = mab_us;
+    timing.slots = slots;
+
+    /* slots == 0 (unchanged): send the legacy 6-byte payload so firmware
+     * without the slots field (the MCU) still accepts the command */
+    uint16_t len = (slots != 0) ? sizeof(timing) : DMX_TIMING_LEN_V1;
+
+    return dmx_send_cmd(conn, CMD_DMX_SET_TIMING, (uint8_t *)&timing, len,
+                        NULL, 0, NULL);
+}
+
+int dmx_cmd_set_adaptive(dmx_conn_t *conn, uint16_t keepalive_hz,
+                         uint16_t idle_frames)
+{
+    dmx_timing_adaptive_t adapt;
+
+    /* Timing fields all 0 (= unchanged): this only touches the
+     * adaptive-refresh control */
+    memset(&adapt, 0, sizeof(adapt));
+    adapt.keepalive_hz = keepalive_hz;
+    adapt.idle_frames = idle_frames;
+
+    return dmx_send_cmd(conn, CMD_DMX_SET_TIMING, (uint8_t *)&adapt,
+                        sizeof(adapt), NULL, 0, NULL);
+}
+
+int dmx_cmd_subscribe(dmx_conn_t *conn, uint16_t interval_ms)
+{
+    dmx_subscribe_payload_t sub;
+    sub.interval_ms = interval_ms;
+
+    return dmx_send_cmd(conn, CMD_DMX_SUBSCRIBE, (uint8_t *)&sub,
+                        sizeof(sub), NULL, 0, NULL);
+}
+
+int dmx_recv_event(dmx_conn_t *conn, uint8_t *type, uint8_t *buf,
+                   uint16_t buf_size, uint16_t *len)
+{
+    if (!conn) {
+        return DMX_ERR_ARG;
+    }
+
+    /* Event framing matches a v1 response: [magic][type][len:2][data][sum] */
+    uint8_t pkt[DMX_MAX_PAYLOAD];
+    int total = recv_packet(conn, pkt, sizeof(pkt));
+    if (total < 0) {
+        return DMX_ERR_TIMEOUT;
+    }
+
+    if (pkt[0] != DMX_MAGIC_EVENT) {
+        return DMX_ERR_PROTOCOL;
+    }
+
+    uint16_t data_len = pkt[2] | (pkt[3] << 8);
+    if (total != 4 + data_len + 1 || data_len > buf_size) {
+        return DMX_ERR_PROTOCOL;
+    }
+    if (!dmx_verify_checksum(pkt, total)) {
+        return DMX_ERR_PROTOCOL;
+    }
+
+    if (data_len > 0) {
+        memcpy(buf, &pkt[4], data_len);
+    }
+    if (type) {
+        *type = pkt[1];
+    }
+    if (len) {
+        *len = data_len;
+    }
+    return DMX_OK;
+}
+
+int dmx_batch_append(uint8_t *buf, uint16_t *len, uint8_t cmd,
+                     const uint8_t *payload, uint16_t payload_len)
+{
+    if (!buf || !len || cmd == CMD_DMX_BATCH) {
+        return DMX_ERR_ARG;
+    }
+
+    /* Entry header + payload must leave room for the outer packet framing */
+    if ((uint32_t)*len + 3 + payload_len > DMX_MAX_PAYLOAD - 5) {
+        return DMX_ERR_ARG;
+    }
+
+    buf[*len]     = cmd;
+    buf[*len + 1] = payload_len & 0xFF;
+    buf[*len + 2] = (payload_len >> 8) & 0xFF;
+    if (payload_len > 0) {
+        memcpy(&buf[*len + 3], payload, payload_len);
+    }
+    *len += 3 + payload_len;
+
+    return DMX_OK;
+}
+
+int dmx_cmd_batch(dmx_conn_t *conn, const uint8_t *batch, uint16_t batch_len,
+                  uint8_t *resp_buf, uint16_t resp_buf_size, uint16_t *resp_len)
+{
+    if (!batch || batch_len < 3) {
+        return DMX_ERR_ARG;
+    }
+
+    return dmx_send_cmd(conn, CMD_DMX_BATCH, batch, batch_len,
+                        resp_buf, resp_buf_size, resp_len);
+}
+
+int dmx_cmd_get_timing(dmx_conn_t *conn, dmx_timing_payload_t *timing)
+{
+    uint8_t resp_buf[sizeof(dmx_timing_payload_t)];
+    uint16_t resp_len;
+
+    int ret = dmx_send_cmd(conn, CMD_DMX_GET_TIMING, NULL, 0,
+                           resp_buf, sizeof(resp_buf), &resp_len);
+    if (ret != DMX_OK) {
+        return ret;
+    }
+    /* 6 bytes = firmware without the slots field (the MCU) */
+    if (resp_len != sizeof(dmx_timing_payload_t) && resp_len != DMX_TIMING_LEN_V1) {
+        return DMX_ERR_PROTOCOL;
+    }
+
+    if (timing) {
+        timing->slots = 0;  /* Unknown unless reported */
+        memcpy(timing, resp_buf, resp_len);
+    }
+    return DMX_OK;
+}
@@ -0,0 +1,482 @@
+/* SPDX-License-Identifier: BSD-3-Clause */
+/*
+ * Copyright (c) 2025 Pierre Jay
+ *
+ * libdmx - DMX512 RPMSG client library.
+ *
+ * Stable C API around the binary RPMSG protocol (dmx_protocol.h), so that
+ * the gateway (or any other process) can link against the client logic
+ * directly instead of spawning the `dmx` CLI per command.
+ *
+ * All calls return 0 (DMX_OK) on success or a negative DMX_ERR_* code.
+ * Results are returned in the protocol payload structs - no printing.
+ */
+
+#ifndef LIBDMX_H
+#define LIBDMX_H
+
+#include <stdint.h>
+#include "dmx_protocol.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* ============================================================================
+ * Error Codes
+ * ============================================================================ */
+
+enum {
+    DMX_OK            = 0,
+    DMX_ERR_IO        = -1,   /* read/write/open failed (see errno) */
+    DMX_ERR_TIMEOUT   = -2,   /* No (complete) response within timeout */
+    DMX_ERR_PROTOCOL  = -3,   /* Bad magic, checksum or response size */
+    DMX_ERR_STATUS    = -4,   /* Firmware returned non-OK status
+                                 (see dmx_last_status()) */
+    DMX_ERR_ARG       = -5,   /* Invalid argument */
+    DMX_ERR_BUSY      = -6,   /* Too many commands in flight */
+};
+
+/* Pipelining window for the async API (bounded by vring buffer count) */
+#define DMX_MAX_INFLIGHT  8
+
+/* ============================================================================
+ * Connection Handle
+ * ============================================================================ */
+
+/* Opaque connection handle - one open RPMSG device */
+typedef struct dmx_conn dmx_conn_t;
+
+/*
+ * Open an RPMSG device and configure it for raw binary mode
+ *
+ * Args:
+ *   device: Device path (e.g. "/dev/ttyRPMSG0"), NULL for the default
+ *
+ * Returns: handle on success, NULL on error (errno set)
+ */
+dmx_conn_t *dmx_open(const char *device);
+
+/*
+ * Open a raw rpmsg_char transport, bypassing the kernel tty layer (AP
+ * firmware only - needs its DMX_RAW_EPT_ADDR endpoint)
+ *
+ * Same protocol as dmx_open(), but each rpmsg message keeps its packet
+ * boundary: one read() returns one complete response, with no line
+ * discipline, tty buffering or stream reassembly in the path.
+ *
+ * Args:
+ *   device: an rpmsg control device (e.g. "/dev/rpmsg_ctrl0" - the
+ *           endpoint is created via ioctl and destroyed on close), or
+ *           a pre-created endpoint node (e.g. "/dev/rpmsg0"); NULL for
+ *           the default control device
+ *
+ * Returns: handle on success, NULL on error (errno set)
+ */
+dmx_conn_t *dmx_open_raw(const char *device);
+
+/*
+ * Close connection and free the handle (NULL is a no-op)
+ */
+void dmx_close(dmx_conn_t *conn);
+
+/*
+ * Get the underlying file descriptor (for select/poll integration)
+ */
+int dmx_fd(const dmx_conn_t *conn);
+
+/*
+ * Set response timeout in milliseconds (default: 1000)
+ */
+void dmx_set_timeout(dmx_conn_t *conn, int timeout_ms);
+
+/*
+ * Enable/disable fire-and-forget mode (default: off)
+ *
+ * When enabled, write-type commands (SET_CHANNELS, SET_SPARSE, ENABLE,
+ * DISABLE, BLACKOUT, SET_TIMING, FADE, STAGE, COMMIT) are sent with
+ * DMX_CMD_FLAG_NO_ACK and return
+ * DMX_OK without waiting for a response. Read-type commands are not
+ * affected. Errors surface in the firmware error counter instead.
+ */
+void dmx_set_no_ack(dmx_conn_t *conn, int enable);
+
+/*
+ * Select the target universe for subsequent commands (default: 0)
+ *
+ * Universe 0 uses v1 framing (unchanged wire format). A non-zero
+ * universe is carried in the v2 header byte, so those commands are
+ * routed through v2 framing transparently - same blocking semantics.
+ * The firmware answers STATUS_INVALID_UNIVERSE for an unfitted index.
+ */
+void dmx_set_universe(dmx_conn_t *conn, uint8_t universe);
+
+/*
+ * Get the firmware status byte of the last completed round trip
+ * (meaningful after DMX_ERR_STATUS)
+ */
+uint8_t dmx_last_status(const dmx_conn_t *conn);
+
+/*
+ * Human-readable string for a DMX_ERR_* code
+ */
+const char *dmx_error_string(int err);
+
+/* ============================================================================
+ * Commands
+ * ============================================================================ */
+
+int dmx_cmd_enable(dmx_conn_t *conn);
+int dmx_cmd_disable(dmx_conn_t *conn);
+int dmx_cmd_blackout(dmx_conn_t *conn);
+
+/*
+ * Set a contiguous range of channels
+ *
+ * Args:
+ *   start: First channel, 0-indexed (0-511)
+ *   values: Channel values
+ *   count: Number of channels (start + count <= 512)
+ */
+int dmx_cmd_set_channels(dmx_conn_t *conn, uint16_t start,
+                         const uint8_t *values, uint16_t count);
+
+/*
+ * Set N non-contiguous channels in one round trip
+ *
+ * Cheaper than dmx_cmd_set_channels() when the touched channels are
+ * scattered (3 bytes per channel on the wire instead of the full span).
+ *
+ * Args:
+ *   channels: Channel numbers, 0-indexed (0-511)
+ *   values: One value per channel
+ *   count: Number of pairs
+ */
+int dmx_cmd_set_sparse(dmx_conn_t *conn, const uint16_t *channels,
+                       const uint8_t *values, uint16_t count);
+
+/*
+ * Stage a contiguous range of channels without touching the live frame
+ *
+ * Staged values sit in a pending buffer until dmx_cmd_commit() folds
+ * them into the output at the next frame boundary. Stage the bulk data
+ * on every target first, then commit each in quick succession - cues
+ * spanning several outputs no longer tear across them.
+ *
+ * Args:
+ *   start: First channel, 0-indexed (0-511)
+ *   values: Channel values
+ *   count: Number of channels (start + count <= 512)
+ */
+int dmx_cmd_stage(dmx_conn_t *conn, uint16_t start,
+                  const uint8_t *values, uint16_t count);
+
+/*
+ * Commit all staged channels at the next frame boundary
+ *
+ * Tiny packet, one round trip. A commit with nothing staged is a no-op.
+ */
+int dmx_cmd_commit(dmx_conn_t *conn);
+
+/*
+ * Fade a contiguous range of channels to target values
+ *
+ * The firmware interpolates per frame on the coprocessor - one round
+ * trip regardless of duration, steps frame-locked at the refresh rate.
+ * A new fade replaces the active one; blackout cancels it.
+ *
+ * Args:
+ *   start: First channel, 0-indexed (0-511)
+ *   targets: Target values
+ *   count: Number of channels (start + count <= 512)
+ *   duration_ms: Fade duration (0 = immediate, max DMX_FADE_MAX_MS)
+ *   easing: DMX_FADE_LINEAR or DMX_FADE_EASE
+ */
+int dmx_cmd_fade(dmx_conn_t *conn, uint16_t start, const uint8_t *targets,
+                 uint16_t count, uint16_t duration_ms, uint8_t easing);
+
+/*
+ * Store the current output into a firmware scene slot (AP firmware
+ * only). Slots are global across universes and survive a firmware
+ * restart (reserved DDR), but not a power cycle.
+ *
+ * Args:
+ *   scene: Scene slot (0 to DMX_SCENE_COUNT-1)
+ */
+int dmx_cmd_scene_store(dmx_conn_t *conn, uint8_t scene);
+
+/*
+ * Recall a stored scene onto the connection's universe (AP firmware
+ * only). Recalling a slot that has never been stored fails with
+ * DMX_ERR_STATUS.
+ *
+ * Args:
+ *   scene: Scene slot (0 to DMX_SCENE_COUNT-1)
+ *   duration_ms: Crossfade duration (0 = instant atomic recall)
+ *   easing: DMX_FADE_LINEAR or DMX_FADE_EASE (ignored when instant)
+ */
+int dmx_cmd_scene_recall(dmx_conn_t *conn, uint8_t scene, uint16_t duration_ms,
+                         uint8_t easing);
+
+int dmx_cmd_get_status(dmx_conn_t *conn, dmx_status_payload_t *status);
+
+/*
+ * Get high-resolution frame timing stats (BREAK-to-BREAK periods
+ * measured with the firmware's 24MHz timer: min/max/mean/p99 plus a
+ * jitter histogram - see dmx_stats_payload_t). AP firmware only.
+ */
+int dmx_cmd_get_stats(dmx_conn_t *conn, dmx_stats_payload_t *stats);
+
+/*
+ * Reassembled CMD_DMX_GET_UNIVERSE readback (see dmx_cmd_get_universe)
+ */
+typedef struct {
+    uint8_t enabled;                    /* 1 = transmission running */
+    uint16_t refresh_hz;                /* Current frame rate (Hz) */
+    uint16_t break_us;                  /* Current BREAK duration (µs) */
+    uint16_t mab_us;                    /* Current MAB duration (µs) */
+    uint16_t slots;                     /* Channels per frame (1-512) */
+    uint8_t channels[DMX_MAX_CHANNELS]; /* Live channel values */
+} dmx_universe_state_t;
+
+/*
+ * Read back the full state of the connection's universe (AP firmware
+ * only): enable flag, timing config and all 512 live channel values.
+ * Fetches the channel data in DMX_UNIVERSE_CHUNK_MAX-sized chunks under
+ * the hood (a full universe does not fit in one RPMSG buffer).
+ *
+ * This is the warm-restart recovery path: after a Linux reboot the
+ * firmware keeps transmitting, and a fresh client can resynchronize
+ * from this snapshot instead of blacking out and replaying the show.
+ */
+int dmx_cmd_get_universe(dmx_conn_t *conn, dmx_universe_state_t *state);
+
+/*
+ * Arm the firmware's wire-level capture (universe-1 UART RX loopback
+ * wired to the universe-0 TX pin; see CMD_DMX_CAPTURE in
+ * dmx_protocol.h). AP firmware only. The capture stops itself after
+ * the requested number of frames.
+ *
+ * Args:
+ *   frames: Full frames to capture (1 to DMX_CAPTURE_MAX_FRAMES)
+ */
+int dmx_cmd_capture_start(dmx_conn_t *conn, uint16_t frames);
+
+/*
+ * Read the capture results (report->running stays 1 until the capture
+ * has collected all requested frames)
+ */
+int dmx_cmd_capture_report(dmx_conn_t *conn, dmx_capture_payload_t *report);
+
+/*
+ * Set timing - 0 for any field keeps the current value
+ *
+ * slots sets the universe length (1-512 channels per frame); shorter
+ * frames allow proportionally higher refresh rates (64 slots ~290 Hz).
+ * With slots == 0 the legacy 6-byte payload is sent, which firmware
+ * without the slots field (the MCU) also accepts.
+ */
+int dmx_cmd_set_timing(dmx_conn_t *conn, uint16_t refresh_hz,
+                       uint16_t break_us, uint16_t mab_us, uint16_t slots);
+
+int dmx_cmd_get_timing(dmx_conn_t *conn, dmx_timing_payload_t *timing);
+
+/*
+ * Configure adaptive refresh (AP firmware only)
+ *
+ * With keepalive_hz > 0 the universe drops to that rate after
+ * idle_frames unchanged frames and snaps back to full rate on the
+ * first write; 0 disables the mode. The effective rate and throttle
+ * state are visible in the status payload.
+ *
+ * Args:
+ *   keepalive_hz: Idle refresh rate (1 to refresh_hz), 0 = disable
+ *   idle_frames: Unchanged frames before throttling (0 = firmware
+ *                default, DMX_ADAPT_IDLE_FRAMES_DEFAULT)
+ */
+int dmx_cmd_set_adaptive(dmx_conn_t *conn, uint16_t keepalive_hz,
+                         uint16_t idle_frames);
+
+/*
+ * Subscribe to pushed status events (AP firmware only)
+ *
+ * After this succeeds the firmware sends one status event per interval
+ * on this connection until dmx_cmd_subscribe(conn, 0) or the link
+ * drops; read them with dmx_recv_event(). One subscriber at a time -
+ * a new subscribe replaces the previous one. The subscription tracks
+ * the universe dmx_set_universe() selected when subscribing.
+ *
+ * Args:
+ *   interval_ms: Push period in ms (clamped to DMX_SUB_INTERVAL_MIN_MS),
+ *                0 = unsubscribe
+ */
+int dmx_cmd_subscribe(dmx_conn_t *conn, uint16_t interval_ms);
+
+/*
+ * Receive one pushed event packet (blocking, connection timeout)
+ *
+ * Only valid between subscribe and unsubscribe - events and command
+ * responses share the connection, so issuing other commands while
+ * subscribed interleaves the two and confuses both readers.
+ *
+ * Args:
+ *   type: Out - event type (the command whose response payload follows,
+ *         currently CMD_DMX_GET_STATUS); may be NULL
+ *   buf: Out - event payload
+ *   len: Out - payload length; may be NULL
+ *
+ * Returns: DMX_OK, DMX_ERR_TIMEOUT if no event arrived in time, or
+ *          DMX_ERR_PROTOCOL on framing/checksum errors
+ */
+int dmx_recv_event(dmx_conn_t *conn, uint8_t *type, uint8_t *buf,
+                   uint16_t buf_size, uint16_t *len);
+
+/* ============================================================================
+ * Batched Commands
+ * ============================================================================ */
+
+/*
+ * Append one sub-command entry ([cmd:1][len:2][data]) to a batch payload
+ *
+ * Args:
+ *   buf: Batch payload buffer (DMX_MAX_PAYLOAD bytes)
+ *   len: In/out cumulative payload length (start at 0)
+ *
+ * Returns: DMX_OK, or DMX_ERR_ARG if the entry doesn't fit
+ */
+int dmx_batch_append(uint8_t *buf, uint16_t *len, uint8_t cmd,
+                     const uint8_t *payload, uint16_t payload_len);
+
+/*
+ * Send an assembled batch in one round trip
+ *
+ * resp_buf receives the concatenated [status:1][len:2][data] results,
+ * one entry per sub-command, in order (dmx_batch_result_t layout).
+ */
+int dmx_cmd_batch(dmx_conn_t *conn, const uint8_t *batch, uint16_t batch_len,
+                  uint8_t *resp_buf, uint16_t resp_buf_size, uint16_t *resp_len);
+
+/* ============================================================================
+ * Shared-Memory Universe Mirror (zero-copy channel path)
+ * ============================================================================ */
+
+/* Opaque mirror handle - one /dev/mem mapping of dmx_shm_universe_t */
+typedef struct dmx_shm dmx_shm_t;
+
+/*
+ * Map the shared-memory universe mirror (DMX_SHM_PHYS_ADDR via /dev/mem)
+ *
+ * Publishing through the mirror skips the whole RPMSG tty path - no
+ * packetization, no checksum, no vring copy. Control commands still
+ * need an open dmx_conn_t; only bulk channel data moves here.
+ *
+ * Requires root (or CAP_SYS_RAWIO) for /dev/mem.
+ *
+ * Returns: handle on success, NULL on error (errno set)
+ */
+dmx_shm_t *dmx_shm_open(void);
+
+/*
+ * Unmap and free the mirror handle (NULL is a no-op)
+ */
+void dmx_shm_close(dmx_shm_t *shm);
+
+/*
+ * Check whether the firmware has initialized the mirror (magic present)
+ *
+ * Returns: 1 if ready, 0 otherwise
+ */
+int dmx_shm_ready(const dmx_shm_t *shm);
+
+/*
+ * Publish a contiguous range of channels through the mirror
+ *
+ * Seqlock write: bump to odd, memcpy, bump to even - sub-microsecond,
+ * no round trip. The TX thread picks the data up at the next frame.
+ * Single writer assumed; do not publish from several processes at once.
+ *
+ * Args:
+ *   start: First channel, 0-indexed (0-511)
+ *   values: Channel values
+ *   count: Number of channels (start + count <= 512)
+ *
+ * Returns: DMX_OK, DMX_ERR_PROTOCOL if the firmware side is not up,
+ *          or DMX_ERR_ARG
+ */
+int dmx_shm_publish(dmx_shm_t *shm, uint16_t start,
+                    const uint8_t *values, uint16_t count);
+
+/* ============================================================================
+ * Async API (protocol v2, pipelined)
+ * ============================================================================ */
+
+/*
+ * Send a command without waiting for its response (protocol v2 framing)
+ *
+ * Up to DMX_MAX_INFLIGHT commands may be outstanding; responses are
+ * collected with dmx_recv_async() and matched by tag. With ~100µs
+ * one-way RPMSG latency, keeping the pipe full roughly triples command
+ * throughput over the synchronous API.
+ *
+ * Args:
+ *   tag_out: Receives the sequence tag assigned to this command (may be NULL)
+ *
+ * Returns: DMX_OK, DMX_ERR_BUSY if the window is full, or DMX_ERR_*
+ */
+int dmx_send_async(dmx_conn_t *conn, uint8_t cmd,
+                   const uint8_t *payload, uint16_t payload_len, uint8_t *tag_out);
+
+/*
+ * Receive one outstanding v2 response
+ *
+ * Responses arrive in command order (firmware dispatch is serialized);
+ * the echoed tag is returned so the caller can pair them regardless.
+ *
+ * Args:
+ *   tag_out: Receives the echoed sequence tag (may be NULL)
+ *
+ * Returns: DMX_OK, DMX_ERR_STATUS if the firmware rejected the command
+ *          (tag and payload still valid), or DMX_ERR_*
+ */
+int dmx_recv_async(dmx_conn_t *conn, uint8_t *tag_out,
+                   uint8_t *resp_buf, uint16_t resp_buf_size, uint16_t *resp_len);
+
+/*
+ * Number of commands currently in flight
+ */
+int dmx_inflight(const dmx_conn_t *conn);
+
+/* ============================================================================
+ * Low-level API (packet engine)
+ * ============================================================================ */
+
+/*
+ * Build a command packet into buf (must hold DMX_CMD_SIZE(payload_len) bytes)
+ *
+ * Returns: total packet size
+ */
+int dmx_build_cmd_packet(uint8_t *buf, uint8_t cmd,
+                         const uint8_t *payload, uint16_t payload_len);
+
+/*
+ * Build a v2 command packet (with sequence tag and universe) into buf
+ *
+ * Returns: total packet size
+ */
+int dmx_build_cmd_packet_v2(uint8_t *buf, uint8_t cmd, uint8_t seq, uint8_t universe,
+                            const uint8_t *payload, uint16_t payload_len);
+
+/*
+ * Send a raw command and receive the response payload
+ *
+ * Returns: DMX_OK or a DMX_ERR_* code
+ */
+int dmx_send_cmd(dmx_conn_t *conn, uint8_t cmd,
+                 const uint8_t *payload, uint16_t payload_len,
+                 uint8_t *resp_buf, uint16_t resp_buf_size, uint16_t *resp_len);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* LIBDMX_H */
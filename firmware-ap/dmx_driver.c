@@ -9,6 +9,7 @@
 #include <rtdevice.h>
 #include "hal_base.h"
 #include "iomux.h"
+#include "dmx_protocol.h"
 #include "dmx_driver.h"
 
 /* SystemCoreClock from CMSIS */
@@ -18,39 +19,200 @@ extern uint32_t SystemCoreClock;
  * Hardware Definitions
  * ============================================================================ */
 
-/* DEBUG MODE: Uncomment to send "HELLO\n" instead of DMX frames */
+/* DEBUG MODE: Uncomment to send "HELLO\n" instead of DMX frames (universe 0) */
 // #define DMX_DEBUG_TEXT_MODE
 
-#define UART_DEVICE_NAME    "uart3"
 #define DMX_BAUDRATE        250000      /* DMX512 uses 250kbaud */
 
+/*
+ * Per-universe UART wiring. Universe 0 is the original UART3 output.
+ * Universe 1 targets UART5, which neither Linux config claims; driving it
+ * needs the matching iomux and a GIC_AMP_IRQ_CFG_ROUTE entry for its IRQ
+ * in the AMP dtsi (see custom-configs). If the device is absent at boot
+ * the universe is skipped and only a warning is printed.
+ */
+static const struct {
+    const char *dev_name;               /* RT-Thread device name */
+    uint32_t base;                      /* UART register base */
+    int irq;                            /* TX interrupt vector */
+} uni_cfg[DMX_NUM_UNIVERSES] = {
+    { "uart3", UART3_BASE, UART3_IRQn },
+    { "uart5", UART5_BASE, UART5_IRQn },
+};
+
 /* ============================================================================
- * Global State
+ * Per-Universe State
  * ============================================================================ */
 
-static struct {
-    rt_device_t uart_dev;               /* UART3 device handle */
+typedef struct dmx_universe {
+    bool present;                       /* UART found and configured */
+    rt_device_t uart_dev;               /* UART device handle */
     volatile struct UART_REG *uart_hw;  /* Direct hardware access (VALIDATED!) */
-    rt_thread_t tx_thread;              /* DMX transmission thread */
-    rt_mutex_t mutex;                   /* Buffer access mutex */
+    rt_mutex_t wr_mutex;                /* Serializes WRITERS only - the TX
+                                           thread never takes it */
+
+    /* Interrupt-driven TX engine state (owned by uart_tx_start/wait + ISR) */
+    const uint8_t *tx_buf;              /* Frame being clocked out */
+    volatile size_t tx_pos;             /* Next byte to load into the FIFO */
+    size_t tx_len;                      /* Frame length */
+    volatile bool tx_active;            /* ISR still feeding the FIFO */
+    bool tx_wait;                       /* uart_tx_wait() must block on tx_done */
+    rt_sem_t tx_done;                   /* Signaled when the last byte is loaded */
+
+    /* Double-buffered channel data: writers fill the inactive buffer and
+     * publish it atomically via pub_word; the TX thread reads whatever
+     * buffer is current without ever blocking on a Linux-originated
+     * write. */
+    uint8_t bufs[2][DMX_UNIVERSE_SIZE]; /* DMX channel values (double buffer) */
+    volatile uint32_t pub_word;         /* Packed publish descriptor (see DMX_PUB_*) */
+    uint8_t wr_idx;                     /* Currently published buffer (writer's view) */
+    uint16_t wr_gen;                    /* Publish generation (writer's view) */
+    uint32_t consumed_word;             /* Last descriptor the TX thread consumed */
 
-    uint8_t channels[DMX_UNIVERSE_SIZE]; /* DMX channel values */
     uint8_t frame_buf[DMX_FRAME_SIZE];  /* TX buffer (start code + channels) */
 
+    /* Shared-memory universe mirror (zero-copy bulk channel path).
+     * Only wired up for universe 0 - there is a single mirror region. */
+    volatile dmx_shm_universe_t *shm;   /* Mirror in amp_shmem_reserved */
+    uint32_t shm_seq_seen;              /* Last seqlock generation consumed */
+
+    /* Staged channel data (folded into the live frame by dmx_commit()
+     * in one atomic publish - see dmx_stage_channels()) */
+    bool stage_pending;                 /* At least one channel staged */
+    uint16_t stage_lo;                  /* First staged channel */
+    uint16_t stage_hi;                  /* Last staged channel */
+    uint8_t stage_buf[DMX_UNIVERSE_SIZE];       /* Staged values */
+    uint32_t stage_map[DMX_UNIVERSE_SIZE / 32]; /* Which channels are staged */
+
+    /* Keyframe fade engine (stepped by the TX thread once per frame) */
+    volatile bool fade_active;          /* Interpolation in progress */
+    uint16_t fade_start;                /* First channel of the fade span */
+    uint16_t fade_count;                /* Channels in the span */
+    uint8_t fade_from[DMX_UNIVERSE_SIZE];   /* Snapshot at fade start */
+    uint8_t fade_to[DMX_UNIVERSE_SIZE];     /* Target values */
+    rt_tick_t fade_begin;               /* Tick the fade started */
+    uint32_t fade_ticks;                /* Duration in ticks (>= 1) */
+    uint8_t fade_easing;                /* DMX_FADE_LINEAR / DMX_FADE_EASE */
+
     volatile bool enabled;              /* Transmission enabled */
-    volatile bool running;              /* Thread running flag */
 
-    uint16_t refresh_hz;                /* Frame rate in Hz (1-44) */
+    uint16_t refresh_hz;                /* Frame rate in Hz */
     uint16_t break_us;                  /* BREAK duration (actual µs) */
     uint16_t mab_us;                    /* MAB duration (actual µs) */
+    uint16_t slots;                     /* Channels per frame (1-512) */
+    rt_tick_t next_due;                 /* Tick deadline for the next frame */
+
+    /* Adaptive refresh (opt-in): full refresh_hz while data changes,
+     * keepalive_hz after adapt_idle unchanged frames */
+    bool adaptive;                      /* Adaptive mode enabled */
+    bool throttled;                     /* Currently at the keep-alive rate */
+    uint16_t keepalive_hz;              /* Idle refresh rate (Hz) */
+    uint16_t adapt_idle;                /* Unchanged frames before throttling */
+    uint32_t unchanged_frames;          /* Consecutive frames without publish */
 
     uint32_t frame_count;               /* Total frames sent */
     uint32_t last_fps_time;             /* For FPS calculation */
     uint32_t last_frame_count;          /* For FPS calculation */
     uint32_t fps;                       /* Current FPS × 100 */
     uint32_t errors;                    /* Error count */
+    uint32_t skipped;                   /* Frames skipped by UART recovery */
+
+    /* High-resolution frame timing stats (24MHz system timer, recorded
+     * at each BREAK - see dmx_stats_record()) */
+    uint64_t stat_last_break;           /* Timer count at the last BREAK */
+    uint32_t stat_min_us;               /* Shortest BREAK-to-BREAK period */
+    uint32_t stat_max_us;               /* Longest BREAK-to-BREAK period */
+    uint64_t stat_sum_us;               /* Period sum (for the mean) */
+    uint32_t stat_samples;              /* Periods measured */
+    uint32_t stat_hist[DMX_STATS_HIST_BINS]; /* |period-nominal| histogram */
+} dmx_universe_t;
+
+static dmx_universe_t g_uni[DMX_NUM_UNIVERSES];
+
+/* State shared by all universes */
+static struct {
+    rt_thread_t tx_thread;              /* Single DMX transmission thread */
+    volatile bool running;              /* Thread running flag */
 } g_dmx;
 
+/* Scene table in reserved DDR - survives a firmware restart, shared by
+ * all universes (mapped in dmx_init()) */
+static volatile dmx_scene_table_t *g_scenes;
+
+/**
+ * Resolve and validate a universe index
+ *
+ * Returns NULL for an out-of-range index or a universe whose UART was
+ * absent at boot.
+ */
+static dmx_universe_t *uni_get(uint8_t universe)
+{
+    if (universe >= DMX_NUM_UNIVERSES || !g_uni[universe].present) {
+        return RT_NULL;
+    }
+    return &g_uni[universe];
+}
+
+/* ============================================================================
+ * Lock-Free Publish (double buffer + atomic descriptor)
+ * ============================================================================ */
+
+/*
+ * pub_word packs everything the TX thread needs into one 32-bit word so
+ * a single volatile read is always self-consistent:
+ *
+ *   [8:0]   dirty_lo   - first channel this publish modified
+ *   [17:9]  dirty_hi   - last channel this publish modified
+ *   [18]    buffer idx - which of bufs[] holds the data
+ *   [31:19] generation - publish counter (detects missed publishes)
+ *
+ * Fixtures typically change <20 channels per update, so the TX thread
+ * only copies [dirty_lo, dirty_hi] into frame_buf - unless it missed a
+ * publish (generation jumped by more than 1), in which case it falls
+ * back to a full copy.
+ */
+#define DMX_PUB_GEN_MASK    0x1FFF
+#define DMX_PUB_WORD(idx, lo, hi, gen) \
+    (((uint32_t)(lo) & 0x1FF) | (((uint32_t)(hi) & 0x1FF) << 9) | \
+     (((uint32_t)(idx) & 1) << 18) | (((uint32_t)(gen) & DMX_PUB_GEN_MASK) << 19))
+#define DMX_PUB_LO(w)       ((uint16_t)((w) & 0x1FF))
+#define DMX_PUB_HI(w)       ((uint16_t)(((w) >> 9) & 0x1FF))
+#define DMX_PUB_IDX(w)      ((uint8_t)(((w) >> 18) & 1))
+#define DMX_PUB_GEN(w)      ((uint16_t)(((w) >> 19) & DMX_PUB_GEN_MASK))
+
+/**
+ * Begin a channel update: sync the inactive buffer with the published
+ * one and return it for modification
+ *
+ * Must be called with u->wr_mutex held (serializes writers; the TX
+ * thread is not involved).
+ */
+static uint8_t *dmx_write_begin(dmx_universe_t *u)
+{
+    uint8_t next = 1 - u->wr_idx;
+
+    rt_memcpy(u->bufs[next], u->bufs[u->wr_idx], DMX_UNIVERSE_SIZE);
+    return u->bufs[next];
+}
+
+/**
+ * Publish the buffer returned by dmx_write_begin()
+ *
+ * [lo, hi] is the channel span this update modified (inclusive).
+ * Must be called with u->wr_mutex held.
+ */
+static void dmx_write_publish(dmx_universe_t *u, uint16_t lo, uint16_t hi)
+{
+    uint8_t next = 1 - u->wr_idx;
+
+    u->wr_idx = next;
+    u->wr_gen = (u->wr_gen + 1) & DMX_PUB_GEN_MASK;
+
+    /* Channel data must be visible before the descriptor */
+    __asm__ volatile("dsb sy" ::: "memory");
+    u->pub_word = DMX_PUB_WORD(next, lo, hi, u->wr_gen);
+}
+
 /* ============================================================================
  * UART Break Generation - LCR METHOD
  * ============================================================================ */
@@ -62,31 +224,125 @@ static struct {
 #define UART_USR_BUSY       (1 << 0)  /* Bit 0: UART Busy */
 #define UART_USR_TFNF       (1 << 1)  /* Bit 1: TX FIFO Not Full */
 #define UART_USR_TFE        (1 << 2)  /* Bit 2: TX FIFO Empty */
+#define UART_IER_ETBEI      (1 << 1)  /* Bit 1: TX Holding Register Empty int */
+#define UART_IER_ERBFI      (1 << 0)  /* Bit 0: RX Data Available int */
+#define UART_IER_ELSI       (1 << 2)  /* Bit 2: RX Line Status int */
+#define UART_IIR_ID_MASK    0x0F      /* Interrupt ID field */
+#define UART_IIR_ID_BUSY    0x07      /* Busy detect (LCR written while busy) */
+#define UART_IIR_ID_RLS     0x06      /* Receiver line status (break/error) */
+#define UART_IIR_ID_RDA     0x04      /* Received data available */
+#define UART_IIR_ID_CTO     0x0C      /* Character timeout (stale RX data) */
+#define UART_LSR_DR         (1 << 0)  /* Bit 0: RX Data Ready */
+#define UART_LSR_OE         (1 << 1)  /* Bit 1: Overrun Error */
+#define UART_LSR_PE         (1 << 2)  /* Bit 2: Parity Error */
+#define UART_LSR_FE         (1 << 3)  /* Bit 3: Framing Error */
+#define UART_LSR_BI         (1 << 4)  /* Bit 4: Break Interrupt */
+
+#define DMX_TIMER_MHZ       24        /* HAL system timer (TIMER5) off the 24MHz OSC */
+
+/*
+ * Idle-wait budgets, measured in TIMER5 time rather than loop
+ * iterations (an iteration count scales with CPU clock and says nothing
+ * about line time). A full 16-byte FIFO tail drains in ~704µs at
+ * 250kbaud; 2ms covers it with margin. The recovery grace only has to
+ * cover the one character that may still be in the shift register.
+ */
+#define UART_IDLE_TIMEOUT_US    2000
+#define UART_RECOVER_GRACE_US   100
+
+/* Wire-level capture RX path (see the Capture Mode section below) */
+static void dmx_capture_rx(volatile struct UART_REG *uart);
 
 /**
- * Wait for UART to be completely idle (CRITICAL for DMX!)
+ * Spin until TX FIFO empty AND not busy, for at most budget_us
  *
- * TODO: Timeout is silent - if we timeout, we continue anyway which could
- * cause weird states. Consider: errors++, log once, recovery sequence
- * (LCR=8N2, FCR=0x07 purge, re-check idle).
+ * Returns true when idle, false if the budget ran out.
  */
-static void uart_wait_idle(volatile struct UART_REG *uart)
+static bool uart_idle_within(volatile struct UART_REG *uart, uint32_t budget_us)
 {
-    int timeout = 100000;  /* Safety timeout */
+    uint64_t start = HAL_GetSysTimerCount();
 
-    while (timeout--) {
+    do {
         uint32_t usr = uart->USR;
 
-        /* Wait for TX FIFO empty (TFE) AND not busy (shift register done) */
         if ((usr & UART_USR_TFE) && !(usr & UART_USR_BUSY)) {
-            return;
+            return true;
         }
+    } while ((uint32_t)((HAL_GetSysTimerCount() - start) / DMX_TIMER_MHZ)
+             < budget_us);
+
+    return false;
+}
+
+/**
+ * Escalating recovery for a wedged TX path
+ *
+ * Step 1: mute the TX interrupt engine, purge the FIFOs and force a
+ * clean 8N2 line state (clears a stuck BREAK/DLAB). Step 2, if the UART
+ * still won't go idle: re-latch the baud divisor with the same DLAB
+ * toggle the init path uses, then purge again. After this the next
+ * frame starts from a known-good UART whatever state it wedged in.
+ */
+static void uart_recover(dmx_universe_t *u)
+{
+    volatile struct UART_REG *uart = u->uart_hw;
+
+    /* The ISR must not refill the FIFO mid-purge */
+    uart->IER = 0;
+    u->tx_active = false;
+
+    /* Step 1: clean line state + FIFO purge */
+    uart->LCR = UART_LCR_8N2;
+    __asm__ volatile("dsb sy" ::: "memory");
+    uart->FCR = UART_FCR_FIFO_EN;
+    __asm__ volatile("dsb sy" ::: "memory");
+
+    if (uart_idle_within(uart, UART_RECOVER_GRACE_US)) {
+        return;
+    }
+
+    /* Step 2: re-latch the baud divisor (DLAB toggle + DLL read, same
+     * sequence as dmx_universe_init) and purge once more */
+    volatile uint32_t dummy;
+    uart->LCR = UART_LCR_8N2 | 0x80;  /* Set DLAB */
+    __asm__ volatile("dsb sy" ::: "memory");
+    dummy = uart->DLL;
+    (void)dummy;
+    uart->LCR = UART_LCR_8N2;         /* Clear DLAB */
+    __asm__ volatile("dsb sy" ::: "memory");
+    uart->FCR = UART_FCR_FIFO_EN;
+    __asm__ volatile("dsb sy" ::: "memory");
+
+    (void)uart_idle_within(uart, UART_RECOVER_GRACE_US);
+}
+
+/**
+ * Wait for UART to be completely idle (CRITICAL for DMX!)
+ *
+ * Returns 0 when idle within the TIMER5-bounded budget. On timeout the
+ * UART is considered wedged: the recovery sequence runs and -1 is
+ * returned so the caller can count the fault and skip the frame -
+ * in a 24/7 installation a stall must cost at most one frame, and the
+ * error/skipped counters make it visible remotely.
+ */
+static int uart_wait_idle(dmx_universe_t *u)
+{
+    if (uart_idle_within(u->uart_hw, UART_IDLE_TIMEOUT_US)) {
+        return 0;
     }
+
+    uart_recover(u);
+    return -1;
 }
 
+#ifdef DMX_DEBUG_TEXT_MODE
 /**
  * Direct polling TX - bypass RT-Thread serial driver entirely.
  *
+ * Only used by the debug text mode; real frames go through the
+ * interrupt-driven engine below (uart_tx_start/wait), which frees CPU2
+ * for the ~22ms it takes to clock out 513 bytes at 250kbaud.
+ *
  * CRITICAL: Forces LCR to known good 8N2 state to ensure:
  * - DLAB=0 (access THR, not DLL)
  * - BREAK=0 (release line if stuck from previous break)
@@ -111,66 +367,620 @@ static void uart_tx_poll(volatile struct UART_REG *uart, const uint8_t *buf, siz
     uart->FCR = UART_FCR_FIFO_EN;
     __asm__ volatile("dsb sy" ::: "memory");
 
-    /* 3. Blast data into FIFO */
+    /* 3. Blast data into FIFO (bounded: a FIFO slot frees every 44µs,
+     * so a full millisecond without one means the UART is wedged) */
     for (size_t i = 0; i < len; i++) {
-        /* Wait for TX FIFO to have space */
+        uint64_t start = HAL_GetSysTimerCount();
         while (!(uart->USR & UART_USR_TFNF)) {
-            /* spin */
+            if ((uint32_t)((HAL_GetSysTimerCount() - start) / DMX_TIMER_MHZ)
+                > 1000) {
+                return;  /* Give up - debug mode, next call retries */
+            }
         }
         uart->THR = buf[i];
     }
 
     /* 4. Wait for transmission to fully complete */
-    while (!((uart->USR & UART_USR_TFE) && !(uart->USR & UART_USR_BUSY))) {
-        /* spin */
+    (void)uart_idle_within(uart, UART_IDLE_TIMEOUT_US);
+}
+#endif /* DMX_DEBUG_TEXT_MODE */
+
+/**
+ * UART TX interrupt handler - refill the FIFO from the current frame
+ *
+ * One instance per universe; param carries the universe it serves.
+ * Fires on THR-empty while a frame is active. When the last byte has
+ * been loaded, THRE interrupts are disabled and the TX thread is woken;
+ * the FIFO tail drains on its own (uart_wait_idle() at the top of the
+ * frame loop covers the final bytes before the next BREAK).
+ */
+static void uart_tx_isr(int vector, void *param)
+{
+    dmx_universe_t *u = (dmx_universe_t *)param;
+    volatile struct UART_REG *uart = u->uart_hw;
+    uint32_t iir = uart->IIR & UART_IIR_ID_MASK;
+
+    /* Busy detect (LCR written while busy): read USR to clear, ignore */
+    if (iir == UART_IIR_ID_BUSY) {
+        (void)uart->USR;
+        return;
+    }
+
+    /* RX interrupts only ever fire on the capture UART (universe 1) while
+     * a wire-level capture is armed - see dmx_capture_start() */
+    if (iir == UART_IIR_ID_RDA || iir == UART_IIR_ID_CTO ||
+        iir == UART_IIR_ID_RLS) {
+        dmx_capture_rx(uart);
+        return;
+    }
+
+    if (!u->tx_active) {
+        uart->IER = 0;  /* Spurious THRE - mute it */
+        return;
+    }
+
+    /* Refill the FIFO */
+    while (u->tx_pos < u->tx_len && (uart->USR & UART_USR_TFNF)) {
+        uart->THR = u->tx_buf[u->tx_pos++];
+    }
+
+    if (u->tx_pos >= u->tx_len) {
+        /* Whole frame loaded - stop THRE interrupts, wake the TX thread */
+        uart->IER = 0;
+        u->tx_active = false;
+        rt_sem_release(u->tx_done);
+    }
+}
+
+/**
+ * Start interrupt-driven TX - prime the FIFO and let the ISR keep it fed.
+ *
+ * Returns immediately so several universes' data phases can run in
+ * parallel; uart_tx_wait() blocks until this universe's frame has been
+ * fully loaded. Keeps the same LCR/FCR forcing as the old polled path
+ * (DLAB=0, BREAK=0, 8N2, FIFO enabled - see uart_send_break_mab notes).
+ */
+static void uart_tx_start(dmx_universe_t *u, const uint8_t *buf, size_t len)
+{
+    volatile struct UART_REG *uart = u->uart_hw;
+
+    /* 1. FORCE LCR to clean 8N2 state (no RMW!) */
+    uart->LCR = UART_LCR_8N2;
+    __asm__ volatile("dsb sy" ::: "memory");
+
+    /*
+     * 2. Enable FIFO (required for USR.TFNF to be valid on DW_apb_uart)
+     *
+     * TODO: FCR=0x07 resets TX/RX FIFOs every frame (overkill).
+     * Could do FCR=0x01 once at init, FCR=0x07 only on error recovery.
+     */
+    uart->FCR = UART_FCR_FIFO_EN;
+    __asm__ volatile("dsb sy" ::: "memory");
+
+    u->tx_buf = buf;
+    u->tx_pos = 0;
+    u->tx_len = len;
+    u->tx_wait = false;
+
+    /* 3. Prime the FIFO as far as it goes */
+    while (u->tx_pos < len && (uart->USR & UART_USR_TFNF)) {
+        uart->THR = buf[u->tx_pos++];
+    }
+
+    if (u->tx_pos >= len) {
+        return;  /* Whole frame fit the FIFO - nothing to wait for */
+    }
+
+    /* 4. Hand the rest to the ISR */
+    u->tx_active = true;
+    u->tx_wait = true;
+    uart->IER = UART_IER_ETBEI;
+}
+
+/**
+ * Block until the frame started by uart_tx_start() is fully loaded.
+ *
+ * 513 bytes at 250kbaud take ~22.6ms; 100ms is generous.
+ */
+static void uart_tx_wait(dmx_universe_t *u)
+{
+    if (!u->tx_wait) {
+        return;  /* Frame fit the FIFO outright */
+    }
+    u->tx_wait = false;
+
+    if (rt_sem_take(u->tx_done, rt_tick_from_millisecond(100)) != RT_EOK) {
+        rt_kprintf("[DMX] ERROR: u%d TX completion timeout (pos=%d/%d)\n",
+                   (int)(u - g_uni), u->tx_pos, u->tx_len);
+        u->uart_hw->IER = 0;
+        u->tx_active = false;
+        u->errors++;
+        /* Drop a late ISR release so the next frame doesn't skip its wait */
+        rt_sem_control(u->tx_done, RT_IPC_CMD_RESET, 0);
+    }
+}
+
+/**
+ * Send UART Break - Direct LCR register access
+ *
+ * Uses hardware timer (TIMER5 @ 24MHz) for accurate timing.
+ * IRQs disabled to prevent jitter during timing-critical section.
+ *
+ * IMPORTANT: Uses absolute LCR writes (no RMW) to avoid BREAK bit getting stuck.
+ */
+static void uart_send_break_mab(volatile struct UART_REG *uart, uint32_t break_us, uint32_t mab_us)
+{
+    /* CRITICAL SECTION: Break + MAB must be atomic */
+    rt_base_t level = rt_hw_interrupt_disable();
+
+    /* BREAK: Set LCR to 8N2 + BREAK bit (absolute write, no RMW) */
+    uart->LCR = UART_LCR_8N2 | UART_LCR_BREAK;
+    __asm__ volatile("dsb sy" ::: "memory");
+    rt_hw_us_delay(break_us);
+
+    /* Clear break: restore clean 8N2 (absolute write) */
+    uart->LCR = UART_LCR_8N2;
+    __asm__ volatile("dsb sy" ::: "memory");
+
+    /* MAB: Mark After Break */
+    rt_hw_us_delay(mab_us);
+
+    rt_hw_interrupt_enable(level);
+}
+
+/* ============================================================================
+ * Shared-Memory Universe Mirror (seqlock reader)
+ * ============================================================================ */
+
+/**
+ * Pull a consistent universe snapshot from the shared-memory mirror
+ *
+ * Called once per frame by the TX thread (universe 0 only - there is a
+ * single mirror region). Publishes cost Linux a memcpy plus two counter
+ * bumps; here we retry a few times if a publish is in flight, and
+ * otherwise just pick the data up on the next frame - at 44Hz a
+ * one-frame delay is invisible.
+ */
+static void dmx_shm_poll(dmx_universe_t *u)
+{
+    volatile dmx_shm_universe_t *shm = u->shm;
+    uint32_t s1, s2;
+
+    if (!shm || shm->magic != DMX_SHM_MAGIC) {
+        return;
+    }
+
+    s1 = shm->seq;
+    if (s1 == u->shm_seq_seen) {
+        return;  /* No new publish since last frame */
+    }
+
+    /*
+     * Copy straight into the inactive double buffer - it is a full
+     * overwrite, so no sync with the published buffer is needed. On a
+     * torn copy we simply don't publish; the unpublished buffer is
+     * re-synced by the next dmx_write_begin().
+     */
+    rt_mutex_take(u->wr_mutex, RT_WAITING_FOREVER);
+
+    uint8_t *buf = u->bufs[1 - u->wr_idx];
+
+    for (int retry = 0; retry < 4; retry++) {
+        s1 = shm->seq;
+        if (s1 & 1) {
+            continue;  /* Publish in progress */
+        }
+
+        __asm__ volatile("dsb sy" ::: "memory");
+        rt_memcpy(buf, (const uint8_t *)shm->channels, DMX_UNIVERSE_SIZE);
+        __asm__ volatile("dsb sy" ::: "memory");
+
+        s2 = shm->seq;
+        if (s1 == s2) {
+            dmx_write_publish(u, 0, DMX_UNIVERSE_SIZE - 1);
+            u->shm_seq_seen = s1;
+            break;
+        }
+    }
+    /* Torn across all retries - the next frame will catch up */
+
+    rt_mutex_release(u->wr_mutex);
+}
+
+/* ============================================================================
+ * Keyframe Fade Engine
+ * ============================================================================ */
+
+/**
+ * Advance an active fade by one frame
+ *
+ * Interpolates the fade span from the start snapshot towards the
+ * targets in 16.16 fixed point and publishes it like any other writer.
+ * Runs in the TX thread right before frame build, so every step is
+ * frame-locked - no Linux-side jitter.
+ */
+static void dmx_fade_step(dmx_universe_t *u)
+{
+    if (!u->fade_active) {
+        return;
+    }
+
+    uint32_t elapsed = (uint32_t)(rt_tick_get() - u->fade_begin);
+    uint32_t t16;  /* Progress, 16.16 fixed point (65536 = done) */
+
+    if (elapsed >= u->fade_ticks) {
+        t16 = 65536;
+    } else {
+        t16 = (uint32_t)(((uint64_t)elapsed << 16) / u->fade_ticks);
+    }
+
+    uint32_t e16 = t16;
+    if (u->fade_easing == DMX_FADE_EASE) {
+        /* Smoothstep 3t²-2t³ in 16.16: t²(3-2t) with a 64-bit product */
+        uint64_t t = t16;
+        e16 = (uint32_t)((t * t * (3 * 65536 - 2 * t)) >> 32);
+    }
+
+    rt_mutex_take(u->wr_mutex, RT_WAITING_FOREVER);
+    uint8_t *buf = dmx_write_begin(u);
+    for (uint16_t i = 0; i < u->fade_count; i++) {
+        int32_t from = u->fade_from[i];
+        int32_t delta = (int32_t)u->fade_to[i] - from;
+        buf[u->fade_start + i] = (uint8_t)(from + ((delta * (int32_t)e16) >> 16));
+    }
+    dmx_write_publish(u, u->fade_start, u->fade_start + u->fade_count - 1);
+    rt_mutex_release(u->wr_mutex);
+
+    if (t16 >= 65536) {
+        u->fade_active = false;
+    }
+}
+
+/* ============================================================================
+ * Frame Timing Statistics (24MHz system timer)
+ * ============================================================================ */
+
+static const uint32_t stats_hist_edges[DMX_STATS_HIST_BINS] = DMX_STATS_HIST_EDGES;
+
+/**
+ * Record one BREAK timestamp and fold the BREAK-to-BREAK period into
+ * the stats
+ *
+ * Called by the TX thread right before uart_send_break_mab(), so the
+ * period measured is what a receiver on the line experiences - the tick
+ * based fps is far too coarse to show jitter. Cost is one timer read
+ * and a handful of integer ops per frame.
+ */
+static void dmx_stats_record(dmx_universe_t *u)
+{
+    uint64_t now = HAL_GetSysTimerCount();
+    uint64_t last = u->stat_last_break;
+
+    u->stat_last_break = now;
+    if (last == 0) {
+        return;  /* First BREAK since enable - no period yet */
+    }
+
+    uint32_t period_us = (uint32_t)((now - last) / DMX_TIMER_MHZ);
+    uint32_t nominal_us = 1000000u / u->refresh_hz;
+    uint32_t dev_us = (period_us > nominal_us) ? period_us - nominal_us
+                                               : nominal_us - period_us;
+
+    if (u->stat_samples == 0 || period_us < u->stat_min_us) {
+        u->stat_min_us = period_us;
+    }
+    if (period_us > u->stat_max_us) {
+        u->stat_max_us = period_us;
+    }
+    u->stat_sum_us += period_us;
+    u->stat_samples++;
+
+    int bin = 0;
+    while (bin < DMX_STATS_HIST_BINS - 1 && dev_us > stats_hist_edges[bin]) {
+        bin++;
+    }
+    u->stat_hist[bin]++;
+}
+
+/**
+ * Restart stats accumulation (on enable, so every run starts clean)
+ */
+static void dmx_stats_reset(dmx_universe_t *u)
+{
+    u->stat_last_break = 0;
+    u->stat_min_us = 0;
+    u->stat_max_us = 0;
+    u->stat_sum_us = 0;
+    u->stat_samples = 0;
+    rt_memset(u->stat_hist, 0, sizeof(u->stat_hist));
+}
+
+/* ============================================================================
+ * Wire-Level Capture Mode (loopback timing validation)
+ * ============================================================================ */
+
+/*
+ * Hardware-in-the-loop check of what actually hits the wire. The test
+ * jig loops the universe-0 TX pin (UART3) back into the universe-1 RX
+ * pin (UART5); we arm RX + line-status interrupts on UART5 and
+ * timestamp break-detect and byte-complete events with the 24MHz system
+ * timer. Capture and universe-1 output are mutually exclusive - the
+ * capture borrows that UART, so universe 1 must be disabled.
+ *
+ * What the RX side can and cannot see (documented in dmx_protocol.h):
+ * the DW UART flags a break after one character time (44µs) low, and
+ * the start code takes 44µs to clock in, so break-detect-to-start-code
+ * equals BREAK+MAB exactly - but the split between the two is invisible
+ * without edge capture. Slot and frame periods come out directly.
+ * IRQ entry latency (~1-2µs on the otherwise idle CPU2) rides on every
+ * timestamp; it cancels in the deltas except for its jitter.
+ */
+static struct {
+    volatile bool active;       /* Armed and collecting */
+    bool await_first;           /* Break seen, waiting for the start code */
+    uint16_t frames_target;     /* Stop after this many full frames */
+    volatile uint16_t frames;   /* Full frames captured so far */
+    uint64_t t_break;           /* Timer count at the last break detect */
+    uint64_t t_last;            /* Timer count at the last byte */
+    uint32_t bytes;             /* Data bytes received */
+    uint32_t errors;            /* Framing/overrun errors */
+    uint32_t bm_min, bm_max;    /* BREAK+MAB extremes (µs) */
+    uint64_t bm_sum;            /* BREAK+MAB sum (for the mean) */
+    uint32_t bm_cnt;
+    uint32_t slot_min, slot_max;/* Byte-to-byte period extremes (µs) */
+    uint64_t slot_sum;
+    uint32_t slot_cnt;
+    uint32_t per_min, per_max;  /* Break-to-break period extremes (µs) */
+    uint64_t per_sum;
+    uint32_t per_cnt;
+    uint32_t hist[DMX_STATS_HIST_BINS]; /* |slot - 44µs| deviations */
+} g_cap;
+
+/**
+ * Fold one µs sample into a min/max/sum/count accumulator
+ */
+static void capture_fold(uint32_t us, uint32_t *min, uint32_t *max,
+                         uint64_t *sum, uint32_t *cnt)
+{
+    if (*cnt == 0 || us < *min) {
+        *min = us;
+    }
+    if (us > *max) {
+        *max = us;
+    }
+    *sum += us;
+    (*cnt)++;
+}
+
+/**
+ * Break detected on the capture UART
+ *
+ * Closes the previous frame (break-to-break period) and re-arms for the
+ * start code. Stops the capture once frames_target full frames are in.
+ */
+static void capture_on_break(uint64_t now)
+{
+    if (g_cap.t_break != 0) {
+        uint32_t period = (uint32_t)((now - g_cap.t_break) / DMX_TIMER_MHZ);
+
+        capture_fold(period, &g_cap.per_min, &g_cap.per_max,
+                     &g_cap.per_sum, &g_cap.per_cnt);
+        g_cap.frames++;
+
+        if (g_cap.frames >= g_cap.frames_target) {
+            g_uni[1].uart_hw->IER = 0;
+            g_cap.active = false;
+            return;
+        }
+    }
+
+    g_cap.t_break = now;
+    g_cap.t_last = 0;
+    g_cap.await_first = true;
+}
+
+/**
+ * Data byte received on the capture UART
+ *
+ * The first byte after a break is the start code: its delta from the
+ * break detect is BREAK+MAB (the two 44µs character times cancel, see
+ * the section comment). Later bytes feed the slot period stats.
+ */
+static void capture_on_byte(uint64_t now)
+{
+    if (g_cap.t_break == 0) {
+        return;  /* Joined mid-frame - wait for the first break */
+    }
+
+    g_cap.bytes++;
+
+    if (g_cap.await_first) {
+        g_cap.await_first = false;
+        capture_fold((uint32_t)((now - g_cap.t_break) / DMX_TIMER_MHZ),
+                     &g_cap.bm_min, &g_cap.bm_max,
+                     &g_cap.bm_sum, &g_cap.bm_cnt);
+    } else if (g_cap.t_last != 0) {
+        uint32_t slot = (uint32_t)((now - g_cap.t_last) / DMX_TIMER_MHZ);
+        uint32_t dev = (slot > 44) ? slot - 44 : 44 - slot;
+
+        capture_fold(slot, &g_cap.slot_min, &g_cap.slot_max,
+                     &g_cap.slot_sum, &g_cap.slot_cnt);
+
+        int bin = 0;
+        while (bin < DMX_STATS_HIST_BINS - 1 && dev > stats_hist_edges[bin]) {
+            bin++;
+        }
+        g_cap.hist[bin]++;
     }
+
+    g_cap.t_last = now;
+}
+
+/**
+ * Capture-UART RX interrupt path (dispatched from uart_tx_isr)
+ *
+ * Drains the RX FIFO, timestamping each event individually - at 44µs
+ * per byte and a 1-char RX trigger there is normally exactly one.
+ */
+static void dmx_capture_rx(volatile struct UART_REG *uart)
+{
+    uint32_t lsr;
+
+    while ((lsr = uart->LSR) & (UART_LSR_DR | UART_LSR_BI)) {
+        uint64_t now = HAL_GetSysTimerCount();
+
+        if (lsr & UART_LSR_BI) {
+            /* The break condition queues a dummy 0x00 - discard it */
+            (void)uart->RBR;
+            if (g_cap.active) {
+                capture_on_break(now);
+            }
+            continue;
+        }
+
+        if (lsr & (UART_LSR_OE | UART_LSR_PE | UART_LSR_FE)) {
+            g_cap.errors++;
+        }
+
+        (void)(uart->RBR);
+        if (g_cap.active) {
+            capture_on_byte(now);
+        }
+    }
+}
+
+int dmx_capture_start(uint16_t frames)
+{
+    dmx_universe_t *u = uni_get(1);
+
+    if (!u || u->enabled || g_cap.active) {
+        return -1;  /* No capture UART, or it is busy transmitting */
+    }
+    if (frames < 1 || frames > DMX_CAPTURE_MAX_FRAMES) {
+        return -1;
+    }
+
+    rt_memset(&g_cap, 0, sizeof(g_cap));
+    g_cap.frames_target = frames;
+
+    volatile struct UART_REG *uart = u->uart_hw;
+
+    /* Clean 8N2, purge FIFOs (FCR also sets the 1-char RX trigger so
+     * every byte interrupts individually), clear stale status */
+    uart->LCR = UART_LCR_8N2;
+    __asm__ volatile("dsb sy" ::: "memory");
+    uart->FCR = UART_FCR_FIFO_EN;
+    __asm__ volatile("dsb sy" ::: "memory");
+    (void)uart->LSR;
+    (void)uart->RBR;
+    (void)uart->USR;
+
+    g_cap.active = true;
+    __asm__ volatile("dsb sy" ::: "memory");
+    uart->IER = UART_IER_ERBFI | UART_IER_ELSI;
+
+    rt_kprintf("[DMX] Capture armed on uart5 RX (%d frames)\n", frames);
+    return 0;
+}
+
+int dmx_capture_report(dmx_capture_payload_t *out)
+{
+    if (!g_uni[1].present) {
+        return -1;
+    }
+
+    /* Snapshot with IRQs off so the 64-bit sums are consistent with
+     * their counts - the capture ISR updates them between reads */
+    rt_base_t level = rt_hw_interrupt_disable();
+
+    rt_memset(out, 0, sizeof(*out));
+    out->running = g_cap.active ? 1 : 0;
+    out->frames = g_cap.frames;
+    out->bytes = g_cap.bytes;
+    out->errors = g_cap.errors;
+    out->break_mab_min_us = g_cap.bm_min;
+    out->break_mab_max_us = g_cap.bm_max;
+    if (g_cap.bm_cnt) {
+        out->break_mab_avg_us = (uint32_t)(g_cap.bm_sum / g_cap.bm_cnt);
+    }
+    out->slot_min_us = g_cap.slot_min;
+    out->slot_max_us = g_cap.slot_max;
+    if (g_cap.slot_cnt) {
+        out->slot_avg_us = (uint32_t)(g_cap.slot_sum / g_cap.slot_cnt);
+    }
+    out->period_min_us = g_cap.per_min;
+    out->period_max_us = g_cap.per_max;
+    if (g_cap.per_cnt) {
+        out->period_avg_us = (uint32_t)(g_cap.per_sum / g_cap.per_cnt);
+    }
+    rt_memcpy(out->hist, g_cap.hist, sizeof(out->hist));
+
+    rt_hw_interrupt_enable(level);
+    return 0;
 }
 
+/* ============================================================================
+ * DMX Transmission Thread (SIMPLE INFINITE LOOP)
+ * ============================================================================ */
+
 /**
- * Send UART Break - Direct LCR register access
- *
- * Uses hardware timer (TIMER5 @ 24MHz) for accurate timing.
- * IRQs disabled to prevent jitter during timing-critical section.
+ * Build the next frame for one universe - LOCK-FREE.
  *
- * IMPORTANT: Uses absolute LCR writes (no RMW) to avoid BREAK bit getting stuck.
+ * Read the publish descriptor, copy the dirty span from the published
+ * buffer, and re-check the descriptor afterwards: if a writer published
+ * again during the copy it may have recycled the buffer we were reading,
+ * so retry with a full copy. frame_buf keeps the last frame, so
+ * untouched channels stay valid and an unchanged universe costs nothing.
  */
-static void uart_send_break_mab(volatile struct UART_REG *uart3, uint32_t break_us, uint32_t mab_us)
+static void dmx_frame_build(dmx_universe_t *u)
 {
-    /* CRITICAL SECTION: Break + MAB must be atomic */
-    rt_base_t level = rt_hw_interrupt_disable();
+    u->frame_buf[0] = 0x00;  /* Start code */
+    for (int retry = 0; retry < 4; retry++) {
+        uint32_t w = u->pub_word;
+        if (w == u->consumed_word) {
+            break;  /* Nothing new */
+        }
 
-    /* BREAK: Set LCR to 8N2 + BREAK bit (absolute write, no RMW) */
-    uart3->LCR = UART_LCR_8N2 | UART_LCR_BREAK;
-    __asm__ volatile("dsb sy" ::: "memory");
-    rt_hw_us_delay(break_us);
+        uint16_t lo = DMX_PUB_LO(w);
+        uint16_t hi = DMX_PUB_HI(w);
 
-    /* Clear break: restore clean 8N2 (absolute write) */
-    uart3->LCR = UART_LCR_8N2;
-    __asm__ volatile("dsb sy" ::: "memory");
+        /* Missed publishes (or retry): the span only describes the
+         * latest one, so take the whole universe */
+        if (retry > 0 ||
+            ((DMX_PUB_GEN(w) - DMX_PUB_GEN(u->consumed_word)) & DMX_PUB_GEN_MASK) != 1) {
+            lo = 0;
+            hi = DMX_UNIVERSE_SIZE - 1;
+        }
 
-    /* MAB: Mark After Break */
-    rt_hw_us_delay(mab_us);
+        __asm__ volatile("dsb sy" ::: "memory");
+        rt_memcpy(&u->frame_buf[1 + lo],
+                  &u->bufs[DMX_PUB_IDX(w)][lo],
+                  (hi - lo) + 1);
+        __asm__ volatile("dsb sy" ::: "memory");
 
-    rt_hw_interrupt_enable(level);
+        u->consumed_word = w;
+        if (u->pub_word == w) {
+            break;  /* No publish landed mid-copy */
+        }
+    }
 }
 
-/* ============================================================================
- * DMX Transmission Thread (SIMPLE INFINITE LOOP)
- * ============================================================================ */
-
 /**
- * DMX transmission thread
+ * DMX transmission thread (all universes)
  *
  * Runs in infinite loop:
- * - If enabled: send frame at fixed period (dmx.refresh_hz)
- * - If disabled: sleep 100ms
+ * - For every enabled universe whose frame period has elapsed: build the
+ *   frame, send BREAK+MAB, start the interrupt-driven data phase
+ * - Then wait for all started data phases to finish
+ * - If nothing is enabled: sleep 100ms
  *
- * 100% CPU usage is OK - we have CPU2 dedicated!
+ * BREAK+MAB runs with IRQs off (~160µs), so those are serialized across
+ * universes; the ~22ms data phases are interrupt-driven and overlap, so
+ * two universes cost barely more CPU than one. Pacing is per universe
+ * via tick deadlines (next_due) - universes may run at different rates.
  */
 static void dmx_tx_thread_entry(void *parameter)
 {
-    uint32_t frame_start;
-
 #ifdef DMX_DEBUG_TEXT_MODE
     rt_kprintf("[DMX] TX thread started - DEBUG TEXT MODE\n");
 #else
@@ -178,66 +988,136 @@ static void dmx_tx_thread_entry(void *parameter)
 #endif
 
     while (g_dmx.running) {
-        if (!g_dmx.enabled) {
-            /* DMX disabled - sleep */
-            rt_thread_mdelay(100);
-            continue;
-        }
+        bool any_enabled = false;
+        uint32_t started = 0;
+        rt_tick_t now = rt_tick_get();
 
 #ifdef DMX_DEBUG_TEXT_MODE
-        /* DEBUG MODE: Send "HELLO\n" every 100ms */
-        const uint8_t test_msg[] = "HELLO\n";
-        uart_tx_poll(g_dmx.uart_hw, test_msg, 6);
-        g_dmx.frame_count++;
+        /* DEBUG MODE: Send "HELLO\n" on universe 0 every 100ms */
+        if (g_uni[0].present && g_uni[0].enabled) {
+            const uint8_t test_msg[] = "HELLO\n";
+            uart_tx_poll(g_uni[0].uart_hw, test_msg, 6);
+            g_uni[0].frame_count++;
+        }
         rt_thread_mdelay(100);  /* 10 Hz for readability */
         continue;
 #endif
 
-        frame_start = rt_tick_get();
+        /* Phase 1: per-universe frame prep + BREAK/MAB + start data */
+        for (int i = 0; i < DMX_NUM_UNIVERSES; i++) {
+            dmx_universe_t *u = &g_uni[i];
+
+            if (!u->present || !u->enabled) {
+                continue;
+            }
+            any_enabled = true;
+
+            /* While throttled, keep watching for writes between
+             * keep-alive frames: the first publish (RPMSG, shared
+             * memory or a starting fade) snaps back to full rate */
+            if (u->throttled) {
+                dmx_shm_poll(u);
+                if (u->pub_word != u->consumed_word || u->fade_active) {
+                    u->throttled = false;
+                    u->unchanged_frames = 0;
+                    u->next_due = now;
+                }
+            }
+
+            if ((rt_int32_t)(now - u->next_due) < 0) {
+                continue;  /* This universe's frame period hasn't elapsed */
+            }
+
+            /* Pull any universe published via the shared-memory mirror */
+            dmx_shm_poll(u);
+
+            /* Advance an active fade (overrides its span for this frame) */
+            dmx_fade_step(u);
+
+            /* Adaptive refresh: after adapt_idle unchanged frames the
+             * pacing drops to the keep-alive rate (receivers hold their
+             * last frame and only need a periodic refresh) */
+            uint16_t pace_hz = u->refresh_hz;
+            if (u->adaptive) {
+                if (u->pub_word != u->consumed_word) {
+                    u->unchanged_frames = 0;
+                    u->throttled = false;
+                } else if (u->unchanged_frames < UINT32_MAX) {
+                    u->unchanged_frames++;
+                    if (u->unchanged_frames >= u->adapt_idle) {
+                        u->throttled = true;
+                    }
+                }
+                if (u->throttled) {
+                    pace_hz = u->keepalive_hz;
+                }
+            }
+            u->next_due = now + RT_TICK_PER_SECOND / pace_hz;
+
+            /* CRITICAL: Wait for previous frame to finish! On a wedged
+             * UART the recovery sequence has already run - count the
+             * fault, skip this frame (at most one frame lost per stall)
+             * and start the next one on the recovered UART. */
+            if (uart_wait_idle(u) < 0) {
+                u->errors++;
+                u->skipped++;
+                continue;
+            }
+
+            dmx_frame_build(u);
+
+            /* Send BREAK + MAB (atomic, timer-based timing) */
+            dmx_stats_record(u);
+            uart_send_break_mab(u->uart_hw, u->break_us, u->mab_us);
 
-        /* CRITICAL: Wait for previous frame to finish! */
-        uart_wait_idle(g_dmx.uart_hw);
+            /* Start DATA via the interrupt-driven engine. Only the
+             * configured slots go on the wire - short universes buy
+             * proportionally higher refresh rates. */
+            uart_tx_start(u, u->frame_buf, 1 + u->slots);
+            started |= 1u << i;
+        }
 
-        /* Lock buffer and prepare frame */
-        rt_mutex_take(g_dmx.mutex, RT_WAITING_FOREVER);
-        g_dmx.frame_buf[0] = 0x00;  /* Start code */
-        rt_memcpy(&g_dmx.frame_buf[1], g_dmx.channels, DMX_UNIVERSE_SIZE);
-        rt_mutex_release(g_dmx.mutex);
+        /* Phase 2: wait for all in-flight data phases (CPU2 sleeps while
+         * the ISRs feed the FIFOs) */
+        for (int i = 0; i < DMX_NUM_UNIVERSES; i++) {
+            if (!(started & (1u << i))) {
+                continue;
+            }
+            dmx_universe_t *u = &g_uni[i];
 
-        /* Send BREAK + MAB (atomic, timer-based timing) */
-        uart_send_break_mab(g_dmx.uart_hw, g_dmx.break_us, g_dmx.mab_us);
+            uart_tx_wait(u);
+            u->frame_count++;
 
-        /* Send DATA via direct polling (bypass RT-Thread serial driver) */
-        uart_tx_poll(g_dmx.uart_hw, g_dmx.frame_buf, DMX_FRAME_SIZE);
-        g_dmx.frame_count++;
+            /* Calculate FPS every second */
+            uint32_t t = rt_tick_get();
+            if (t - u->last_fps_time >= RT_TICK_PER_SECOND) {
+                uint32_t frames_sent = u->frame_count - u->last_frame_count;
+                uint32_t time_ms = (t - u->last_fps_time) * 1000 / RT_TICK_PER_SECOND;
 
-        /* Calculate FPS every second */
-        uint32_t now = rt_tick_get();
-        if (now - g_dmx.last_fps_time >= RT_TICK_PER_SECOND) {
-            uint32_t frames_sent = g_dmx.frame_count - g_dmx.last_frame_count;
-            uint32_t time_ms = (now - g_dmx.last_fps_time) * 1000 / RT_TICK_PER_SECOND;
+                /* FPS × 100 for precision */
+                if (time_ms > 0) {
+                    u->fps = (frames_sent * 100000) / time_ms;
+                }
 
-            /* FPS × 100 for precision */
-            if (time_ms > 0) {
-                g_dmx.fps = (frames_sent * 100000) / time_ms;
+                u->last_fps_time = t;
+                u->last_frame_count = u->frame_count;
             }
+        }
 
-            g_dmx.last_fps_time = now;
-            g_dmx.last_frame_count = g_dmx.frame_count;
+        if (!any_enabled) {
+            /* DMX disabled everywhere - sleep */
+            rt_thread_mdelay(100);
+            continue;
         }
 
         /*
-         * Pacing: At 44Hz we're at physical limit (~22.7ms/frame), just loop.
-         * For lower rates, add delay in µs after frame completion.
+         * Pacing: at 44Hz the line is the limit (~22.7ms/frame) and
+         * uart_wait_idle() gates the next BREAK, so just loop. If no
+         * universe was due, nap a tick until one is.
          */
-        if (g_dmx.refresh_hz < DMX_REFRESH_HZ_MAX) {
-            uint32_t frame_period_us = 1000000 / g_dmx.refresh_hz;
-            uint32_t elapsed_us = (rt_tick_get() - frame_start) * 1000000 / RT_TICK_PER_SECOND;
-            if (elapsed_us < frame_period_us) {
-                rt_hw_us_delay(frame_period_us - elapsed_us);
-            }
+        if (!started) {
+            rt_thread_mdelay(1);
         }
-        /* At max rate (44Hz), continue immediately - no delay needed */
     }
 
     rt_kprintf("[DMX] TX thread stopped\n");
@@ -247,30 +1127,37 @@ static void dmx_tx_thread_entry(void *parameter)
  * Public API
  * ============================================================================ */
 
-int dmx_init(void)
+/**
+ * Bring up one universe's UART + TX engine
+ *
+ * Returns 0 on success, -1 if the UART is absent or failed to configure
+ * (u->present stays false and the universe is skipped at runtime).
+ */
+static int dmx_universe_init(int i)
 {
+    dmx_universe_t *u = &g_uni[i];
     rt_err_t ret;
+    char name[RT_NAME_MAX];
     struct serial_configure config = RT_SERIAL_CONFIG_DEFAULT;
 
-    rt_kprintf("[DMX] Initializing DMX512 driver (simple version)...\n");
-    rt_kprintf("[DMX] SystemCoreClock = %u Hz (%u MHz)\n",
-               SystemCoreClock, SystemCoreClock / 1000000);
-
-    /* Initialize state */
-    rt_memset(&g_dmx, 0, sizeof(g_dmx));
-
     /* DMX timing defaults (timer-based delay is accurate) */
-    g_dmx.refresh_hz = DMX_REFRESH_HZ_DEFAULT;  /* 44 Hz */
-    g_dmx.break_us   = DMX_BREAK_US_DEFAULT;    /* DMX spec: 88-176µs (receiver), using 150µs */
-    g_dmx.mab_us     = DMX_MAB_US_DEFAULT;      /* DMX spec: >8µs (receiver), using 12µs */
+    u->refresh_hz = DMX_REFRESH_HZ_DEFAULT;  /* 44 Hz */
+    u->break_us   = DMX_BREAK_US_DEFAULT;    /* DMX spec: 88-176µs (receiver), using 150µs */
+    u->mab_us     = DMX_MAB_US_DEFAULT;      /* DMX spec: >8µs (receiver), using 12µs */
+    u->slots      = DMX_SLOTS_DEFAULT;       /* Full 512-channel frames */
+
+    /* Publish the (zeroed) initial universe as a full-span update */
+    u->pub_word = DMX_PUB_WORD(0, 0, DMX_UNIVERSE_SIZE - 1, 0);
+    u->consumed_word = ~0U;  /* Force a full copy on the first frame */
 
     /* Direct hardware access (VALIDATED!) */
-    g_dmx.uart_hw = (volatile struct UART_REG *)UART3_BASE;
+    u->uart_hw = (volatile struct UART_REG *)uni_cfg[i].base;
 
-    /* Find UART3 device */
-    g_dmx.uart_dev = rt_device_find(UART_DEVICE_NAME);
-    if (!g_dmx.uart_dev) {
-        rt_kprintf("[DMX] ERROR: UART3 not found\n");
+    /* Find UART device */
+    u->uart_dev = rt_device_find(uni_cfg[i].dev_name);
+    if (!u->uart_dev) {
+        rt_kprintf("[DMX] %s: universe %d UART '%s' not found\n",
+                   i == 0 ? "ERROR" : "WARN", i, uni_cfg[i].dev_name);
         return -RT_ERROR;
     }
 
@@ -283,30 +1170,30 @@ int dmx_init(void)
     config.invert    = NRZ_NORMAL;
     config.bufsz     = 1024;
 
-    ret = rt_device_control(g_dmx.uart_dev, RT_DEVICE_CTRL_CONFIG, &config);
+    ret = rt_device_control(u->uart_dev, RT_DEVICE_CTRL_CONFIG, &config);
     if (ret != RT_EOK) {
-        rt_kprintf("[DMX] ERROR: Failed to configure UART (ret=%d)\n", ret);
-        return ret;
+        rt_kprintf("[DMX] ERROR: Failed to configure %s (ret=%d)\n",
+                   uni_cfg[i].dev_name, ret);
+        return -RT_ERROR;
     }
 
-    /* Open UART via RT-Thread (for init/config), but TX is done via direct register polling */
-    ret = rt_device_open(g_dmx.uart_dev, RT_DEVICE_FLAG_RDWR);
+    /* Open UART via RT-Thread (for init/config), but TX is done via direct register access */
+    ret = rt_device_open(u->uart_dev, RT_DEVICE_FLAG_RDWR);
     if (ret != RT_EOK) {
-        rt_kprintf("[DMX] ERROR: Failed to open UART (ret=%d)\n", ret);
-        return ret;
+        rt_kprintf("[DMX] ERROR: Failed to open %s (ret=%d)\n",
+                   uni_cfg[i].dev_name, ret);
+        return -RT_ERROR;
     }
 
-    rt_kprintf("[DMX] UART3 opened successfully\n");
-
     /*
      * HARDWARE SYNC FIX: Force baud rate latch via DLAB toggle + DLL read.
      * Was added to fix 25Hz issue, but root cause was RMW on LCR (BREAK stuck).
      *
-     * TODO: Now that uart_tx_poll() forces LCR=0x07 before every TX, this
+     * TODO: Now that the TX path forces LCR=0x07 before every frame, this
      * block may be redundant. Test removing it once stability is confirmed.
      */
     {
-        volatile struct UART_REG *reg = g_dmx.uart_hw;
+        volatile struct UART_REG *reg = u->uart_hw;
         uint32_t lcr_save = reg->LCR;
         volatile uint32_t dummy;
 
@@ -318,14 +1205,91 @@ int dmx_init(void)
         __asm__ volatile("dsb sy" ::: "memory");
     }
 
-    /* Create mutex */
-    g_dmx.mutex = rt_mutex_create("dmx_mtx", RT_IPC_FLAG_PRIO);
-    if (!g_dmx.mutex) {
+    /* Create writer mutex (the TX thread never takes it) */
+    rt_snprintf(name, sizeof(name), "dmx_wr%d", i);
+    u->wr_mutex = rt_mutex_create(name, RT_IPC_FLAG_PRIO);
+    if (!u->wr_mutex) {
         rt_kprintf("[DMX] ERROR: Failed to create mutex\n");
         return -RT_ERROR;
     }
 
-    /* Create DMX transmission thread */
+    /* TX completion semaphore + UART interrupt for the TX engine */
+    rt_snprintf(name, sizeof(name), "dmxtxd%d", i);
+    u->tx_done = rt_sem_create(name, 0, RT_IPC_FLAG_PRIO);
+    if (!u->tx_done) {
+        rt_kprintf("[DMX] ERROR: Failed to create TX semaphore\n");
+        return -RT_ERROR;
+    }
+
+    rt_snprintf(name, sizeof(name), "%s_tx", uni_cfg[i].dev_name);
+    rt_hw_interrupt_install(uni_cfg[i].irq, uart_tx_isr, u, name);
+    rt_hw_interrupt_umask(uni_cfg[i].irq);
+
+    /* Initialize FPS tracking */
+    u->last_fps_time = rt_tick_get();
+    u->last_frame_count = 0;
+    u->next_due = rt_tick_get();
+
+    u->present = true;
+    rt_kprintf("[DMX] Universe %d on %s ready\n", i, uni_cfg[i].dev_name);
+    return RT_EOK;
+}
+
+int dmx_init(void)
+{
+    rt_kprintf("[DMX] Initializing DMX512 driver (%d universes)...\n",
+               DMX_NUM_UNIVERSES);
+    rt_kprintf("[DMX] SystemCoreClock = %u Hz (%u MHz)\n",
+               SystemCoreClock, SystemCoreClock / 1000000);
+
+    /* Initialize state */
+    rt_memset(&g_dmx, 0, sizeof(g_dmx));
+    rt_memset(g_uni, 0, sizeof(g_uni));
+
+    /* Universe 0 (UART3) is mandatory; extra universes are best-effort */
+    if (dmx_universe_init(0) != RT_EOK) {
+        return -RT_ERROR;
+    }
+    for (int i = 1; i < DMX_NUM_UNIVERSES; i++) {
+        (void)dmx_universe_init(i);
+    }
+
+    /*
+     * Initialize the shared-memory universe mirror (bound to universe 0 -
+     * there is a single mirror region). Magic goes in last so Linux never
+     * sees a half-initialized header.
+     */
+    g_uni[0].shm = (volatile dmx_shm_universe_t *)DMX_SHM_PHYS_ADDR;
+    g_uni[0].shm->magic = 0;
+    g_uni[0].shm->seq = 0;
+    g_uni[0].shm->publish_count = 0;
+    g_uni[0].shm->rsvd = 0;
+    rt_memset((void *)g_uni[0].shm->channels, 0, DMX_UNIVERSE_SIZE);
+    __asm__ volatile("dsb sy" ::: "memory");
+    g_uni[0].shm->magic = DMX_SHM_MAGIC;
+    g_uni[0].shm_seq_seen = 0;
+
+    rt_kprintf("[DMX] Shared-memory mirror at 0x%08x (seqlock)\n",
+               (uint32_t)DMX_SHM_PHYS_ADDR);
+
+    /*
+     * Map the scene table. A valid magic means the region still holds
+     * scenes from before a firmware restart - keep them; only a cold
+     * (garbage) region gets wiped.
+     */
+    g_scenes = (volatile dmx_scene_table_t *)DMX_SCENE_PHYS_ADDR;
+    if (g_scenes->magic != DMX_SCENE_MAGIC) {
+        rt_memset((void *)g_scenes, 0, sizeof(dmx_scene_table_t));
+        __asm__ volatile("dsb sy" ::: "memory");
+        g_scenes->magic = DMX_SCENE_MAGIC;
+        rt_kprintf("[DMX] Scene table initialized at 0x%08x (%d slots)\n",
+                   (uint32_t)DMX_SCENE_PHYS_ADDR, DMX_SCENE_COUNT);
+    } else {
+        rt_kprintf("[DMX] Scene table recovered (valid_mask=0x%04x)\n",
+                   g_scenes->valid_mask);
+    }
+
+    /* Create DMX transmission thread (shared by all universes) */
     g_dmx.running = RT_TRUE;
 
     g_dmx.tx_thread = rt_thread_create("dmx_tx",
@@ -342,151 +1306,537 @@ int dmx_init(void)
 
     rt_thread_startup(g_dmx.tx_thread);
 
-    /* Initialize FPS tracking */
-    g_dmx.last_fps_time = rt_tick_get();
-    g_dmx.last_frame_count = 0;
-
 #ifdef DMX_DEBUG_TEXT_MODE
     rt_kprintf("[DMX] *** DEBUG TEXT MODE ENABLED ***\n");
     rt_kprintf("[DMX] Will send 'HELLO\\n' every 100ms at 250kbaud\n");
 #else
-    rt_kprintf("[DMX] Driver initialized (250kbaud, 8N2, polling mode)\n");
+    rt_kprintf("[DMX] Driver initialized (250kbaud, 8N2, interrupt TX)\n");
     rt_kprintf("[DMX] UART3 TX = GPIO0_A4 (RM_IO4)\n");
     rt_kprintf("[DMX] Timing: BREAK=%dµs, MAB=%dµs (TIMER5 @ 24MHz)\n",
-               g_dmx.break_us, g_dmx.mab_us);
-    rt_kprintf("[DMX] TX thread running (100%% CPU2 OK - dedicated core)\n");
+               g_uni[0].break_us, g_uni[0].mab_us);
+    rt_kprintf("[DMX] TX thread running (CPU2 idles during the data phase)\n");
 #endif
 
     return RT_EOK;
 }
 
-void dmx_enable(void)
+void dmx_enable(uint8_t universe)
 {
-    if (g_dmx.enabled) {
-        return;  /* Already enabled */
+    dmx_universe_t *u = uni_get(universe);
+
+    if (!u || u->enabled) {
+        return;  /* Absent or already enabled */
+    }
+    if (universe == 1 && g_cap.active) {
+        rt_kprintf("[DMX] Universe 1 UART busy with wire capture - not enabling\n");
+        return;
     }
 
-    rt_kprintf("[DMX] Enabling transmission (44 Hz)\n");
+    rt_kprintf("[DMX] Enabling transmission on universe %d (%d Hz)\n",
+               universe, u->refresh_hz);
 
-    g_dmx.enabled = RT_TRUE;
-    g_dmx.frame_count = 0;
-    g_dmx.last_fps_time = rt_tick_get();
-    g_dmx.last_frame_count = 0;
+    u->frame_count = 0;
+    u->last_fps_time = rt_tick_get();
+    u->last_frame_count = 0;
+    u->next_due = rt_tick_get();
+    dmx_stats_reset(u);
+    u->enabled = RT_TRUE;
 }
 
-void dmx_disable(void)
+void dmx_disable(uint8_t universe)
 {
-    if (!g_dmx.enabled) {
+    dmx_universe_t *u = uni_get(universe);
+
+    if (!u || !u->enabled) {
         return;
     }
 
-    rt_kprintf("[DMX] Disabling transmission\n");
-    g_dmx.enabled = RT_FALSE;
+    rt_kprintf("[DMX] Disabling transmission on universe %d\n", universe);
+    u->enabled = RT_FALSE;
+}
+
+int dmx_set_channel(uint8_t universe, uint16_t channel, uint8_t value)
+{
+    dmx_universe_t *u = uni_get(universe);
+
+    if (!u || channel >= DMX_UNIVERSE_SIZE) {
+        return -RT_ERROR;
+    }
+
+    rt_mutex_take(u->wr_mutex, RT_WAITING_FOREVER);
+    uint8_t *buf = dmx_write_begin(u);
+    buf[channel] = value;
+    dmx_write_publish(u, channel, channel);
+    rt_mutex_release(u->wr_mutex);
+
+    return RT_EOK;
+}
+
+int dmx_set_channels(uint8_t universe, uint16_t start, const uint8_t *values, uint16_t count)
+{
+    dmx_universe_t *u = uni_get(universe);
+
+    if (!u || start + count > DMX_UNIVERSE_SIZE) {
+        return -RT_ERROR;
+    }
+
+    rt_mutex_take(u->wr_mutex, RT_WAITING_FOREVER);
+    uint8_t *buf = dmx_write_begin(u);
+    rt_memcpy(&buf[start], values, count);
+    dmx_write_publish(u, start, start + count - 1);
+    rt_mutex_release(u->wr_mutex);
+
+    return RT_EOK;
+}
+
+int dmx_set_sparse(uint8_t universe, const uint8_t *pairs, uint16_t count)
+{
+    dmx_universe_t *u = uni_get(universe);
+
+    if (!u) {
+        return -RT_ERROR;
+    }
+
+    /* Validate all pairs before touching the buffer (all-or-nothing) */
+    for (uint16_t i = 0; i < count; i++) {
+        uint16_t channel = pairs[i * 3] | (pairs[i * 3 + 1] << 8);
+        if (channel >= DMX_UNIVERSE_SIZE) {
+            return -RT_ERROR;
+        }
+    }
+
+    rt_mutex_take(u->wr_mutex, RT_WAITING_FOREVER);
+    uint8_t *buf = dmx_write_begin(u);
+    uint16_t lo = DMX_UNIVERSE_SIZE - 1;
+    uint16_t hi = 0;
+    for (uint16_t i = 0; i < count; i++) {
+        uint16_t channel = pairs[i * 3] | (pairs[i * 3 + 1] << 8);
+        buf[channel] = pairs[i * 3 + 2];
+        if (channel < lo) {
+            lo = channel;
+        }
+        if (channel > hi) {
+            hi = channel;
+        }
+    }
+    dmx_write_publish(u, lo, hi);
+    rt_mutex_release(u->wr_mutex);
+
+    return RT_EOK;
+}
+
+int dmx_fade_start(uint8_t universe, uint16_t start, const uint8_t *targets,
+                   uint16_t count, uint16_t duration_ms, uint8_t easing)
+{
+    dmx_universe_t *u = uni_get(universe);
+
+    if (!u || !targets || count == 0 || start + count > DMX_UNIVERSE_SIZE ||
+        duration_ms > DMX_FADE_MAX_MS || easing > DMX_FADE_EASE) {
+        return -RT_ERROR;
+    }
+
+    /* Replace any active fade first so a stale step can't land on top */
+    u->fade_active = false;
+
+    /* Zero duration = plain set, no interpolation */
+    if (duration_ms == 0) {
+        return dmx_set_channels(universe, start, targets, count);
+    }
+
+    rt_mutex_take(u->wr_mutex, RT_WAITING_FOREVER);
+    /* Snapshot the current output as the starting keyframe */
+    rt_memcpy(u->fade_from, &u->bufs[u->wr_idx][start], count);
+    rt_memcpy(u->fade_to, targets, count);
+    u->fade_start = start;
+    u->fade_count = count;
+    u->fade_easing = easing;
+    u->fade_begin = rt_tick_get();
+    u->fade_ticks = (uint32_t)duration_ms * RT_TICK_PER_SECOND / 1000;
+    if (u->fade_ticks == 0) {
+        u->fade_ticks = 1;
+    }
+    u->fade_active = true;
+    rt_mutex_release(u->wr_mutex);
+
+    rt_kprintf("[DMX] Fade: u%d ch %d-%d over %dms (%s)\n",
+               universe, start, start + count - 1, duration_ms,
+               easing == DMX_FADE_EASE ? "ease" : "linear");
+
+    return RT_EOK;
+}
+
+int dmx_stage_channels(uint8_t universe, uint16_t start, const uint8_t *values,
+                       uint16_t count)
+{
+    dmx_universe_t *u = uni_get(universe);
+
+    if (!u || !values || count == 0 || start + count > DMX_UNIVERSE_SIZE) {
+        return -RT_ERROR;
+    }
+
+    rt_mutex_take(u->wr_mutex, RT_WAITING_FOREVER);
+    rt_memcpy(&u->stage_buf[start], values, count);
+    for (uint16_t ch = start; ch < start + count; ch++) {
+        u->stage_map[ch / 32] |= 1u << (ch % 32);
+    }
+    if (!u->stage_pending || start < u->stage_lo) {
+        u->stage_lo = start;
+    }
+    if (!u->stage_pending || start + count - 1 > u->stage_hi) {
+        u->stage_hi = start + count - 1;
+    }
+    u->stage_pending = true;
+    rt_mutex_release(u->wr_mutex);
+
+    return RT_EOK;
+}
+
+int dmx_commit(uint8_t universe)
+{
+    dmx_universe_t *u = uni_get(universe);
+
+    if (!u) {
+        return -RT_ERROR;
+    }
+
+    rt_mutex_take(u->wr_mutex, RT_WAITING_FOREVER);
+    if (!u->stage_pending) {
+        /* Nothing staged - harmless, so a cue engine can broadcast
+         * COMMIT to every target unconditionally */
+        rt_mutex_release(u->wr_mutex);
+        return RT_EOK;
+    }
+
+    /* Overlay only the staged channels onto the live data, then publish
+     * the span once - the TX thread picks the whole cue up at its next
+     * frame build, never a partial one */
+    uint8_t *buf = dmx_write_begin(u);
+    for (uint16_t ch = u->stage_lo; ch <= u->stage_hi; ch++) {
+        if (u->stage_map[ch / 32] & (1u << (ch % 32))) {
+            buf[ch] = u->stage_buf[ch];
+        }
+    }
+    dmx_write_publish(u, u->stage_lo, u->stage_hi);
+
+    rt_memset(u->stage_map, 0, sizeof(u->stage_map));
+    u->stage_pending = false;
+    rt_mutex_release(u->wr_mutex);
+
+    return RT_EOK;
 }
 
-int dmx_set_channel(uint16_t channel, uint8_t value)
+int dmx_scene_store(uint8_t universe, uint8_t scene)
 {
-    if (channel >= DMX_UNIVERSE_SIZE) {
+    dmx_universe_t *u = uni_get(universe);
+
+    if (!u || !g_scenes || scene >= DMX_SCENE_COUNT) {
         return -RT_ERROR;
     }
 
-    rt_mutex_take(g_dmx.mutex, RT_WAITING_FOREVER);
-    g_dmx.channels[channel] = value;
-    rt_mutex_release(g_dmx.mutex);
+    /* Snapshot the writer-side view so a store taken right after a set
+     * command captures that command, even if the TX thread has not
+     * pulled the frame yet */
+    rt_mutex_take(u->wr_mutex, RT_WAITING_FOREVER);
+    rt_memcpy((void *)g_scenes->scenes[scene], u->bufs[u->wr_idx],
+              DMX_UNIVERSE_SIZE);
+    __asm__ volatile("dsb sy" ::: "memory");
+    g_scenes->valid_mask |= 1u << scene;
+    rt_mutex_release(u->wr_mutex);
 
+    rt_kprintf("[DMX] Scene %d stored from universe %d\n", scene, universe);
     return RT_EOK;
 }
 
-int dmx_set_channels(uint16_t start, const uint8_t *values, uint16_t count)
+int dmx_scene_recall(uint8_t universe, uint8_t scene, uint16_t duration_ms,
+                     uint8_t easing)
 {
-    if (start + count > DMX_UNIVERSE_SIZE) {
+    dmx_universe_t *u = uni_get(universe);
+
+    if (!u || !g_scenes || scene >= DMX_SCENE_COUNT ||
+        !(g_scenes->valid_mask & (1u << scene))) {
         return -RT_ERROR;
     }
 
-    rt_mutex_take(g_dmx.mutex, RT_WAITING_FOREVER);
-    rt_memcpy(&g_dmx.channels[start], values, count);
-    rt_mutex_release(g_dmx.mutex);
+    if (duration_ms > 0) {
+        /* Crossfade from the current output to the stored look */
+        return dmx_fade_start(universe, 0,
+                              (const uint8_t *)g_scenes->scenes[scene],
+                              DMX_UNIVERSE_SIZE, duration_ms, easing);
+    }
+
+    /* Instant recall: one full-span publish, picked up atomically at the
+     * next frame build */
+    u->fade_active = false;
+
+    rt_mutex_take(u->wr_mutex, RT_WAITING_FOREVER);
+    uint8_t *buf = dmx_write_begin(u);
+    rt_memcpy(buf, (const void *)g_scenes->scenes[scene], DMX_UNIVERSE_SIZE);
+    dmx_write_publish(u, 0, DMX_UNIVERSE_SIZE - 1);
+    rt_mutex_release(u->wr_mutex);
 
+    rt_kprintf("[DMX] Scene %d recalled on universe %d\n", scene, universe);
     return RT_EOK;
 }
 
-void dmx_blackout(void)
+void dmx_blackout(uint8_t universe)
+{
+    dmx_universe_t *u = uni_get(universe);
+
+    if (!u) {
+        return;
+    }
+
+    /* A blackout cancels any fade in progress */
+    u->fade_active = false;
+
+    rt_mutex_take(u->wr_mutex, RT_WAITING_FOREVER);
+    rt_memset(u->bufs[1 - u->wr_idx], 0, DMX_UNIVERSE_SIZE);
+    dmx_write_publish(u, 0, DMX_UNIVERSE_SIZE - 1);
+    /* Discard staged-but-uncommitted data - a cue must not outlive a
+     * blackout */
+    rt_memset(u->stage_map, 0, sizeof(u->stage_map));
+    u->stage_pending = false;
+    rt_mutex_release(u->wr_mutex);
+
+    rt_kprintf("[DMX] Blackout applied (universe %d)\n", universe);
+}
+
+void dmx_count_error(uint8_t universe)
 {
-    rt_mutex_take(g_dmx.mutex, RT_WAITING_FOREVER);
-    rt_memset(g_dmx.channels, 0, DMX_UNIVERSE_SIZE);
-    rt_mutex_release(g_dmx.mutex);
+    dmx_universe_t *u = uni_get(universe);
 
-    rt_kprintf("[DMX] Blackout applied\n");
+    if (u) {
+        u->errors++;
+    }
 }
 
-void dmx_get_status(dmx_driver_status_t *status)
+void dmx_get_status(uint8_t universe, dmx_driver_status_t *status)
 {
+    dmx_universe_t *u = uni_get(universe);
+
     if (!status) {
         return;
     }
+    if (!u) {
+        rt_memset(status, 0, sizeof(*status));
+        return;
+    }
+
+    status->enabled = u->enabled;
+    status->frame_count = u->frame_count;
+    status->fps = u->fps;
+    status->errors = u->errors;
+    status->throttled = u->adaptive && u->throttled;
+    status->effective_hz = status->throttled ? u->keepalive_hz : u->refresh_hz;
+}
+
+void dmx_get_stats(uint8_t universe, dmx_stats_payload_t *stats)
+{
+    dmx_universe_t *u = uni_get(universe);
+
+    if (!stats) {
+        return;
+    }
+    rt_memset(stats, 0, sizeof(*stats));
+    if (!u) {
+        return;
+    }
+
+    /* The TX thread updates concurrently; a slightly torn read is an
+     * acceptable price for keeping the hot path lock-free */
+    stats->frame_count = u->frame_count;
+    stats->errors = u->errors;
+    stats->skipped = u->skipped;
+    stats->samples = u->stat_samples;
+    if (u->stat_samples == 0) {
+        return;
+    }
 
-    status->enabled = g_dmx.enabled;
-    status->frame_count = g_dmx.frame_count;
-    status->fps = g_dmx.fps;
-    status->errors = g_dmx.errors;
+    stats->period_min_us = u->stat_min_us;
+    stats->period_max_us = u->stat_max_us;
+    stats->period_avg_us = (uint32_t)(u->stat_sum_us / u->stat_samples);
+    rt_memcpy(stats->hist, (const void *)u->stat_hist, sizeof(stats->hist));
+
+    /* p99 from the deviation histogram: upper bound of the bin that
+     * crosses the 99th percentile (max for the open-ended last bin) */
+    uint32_t nominal_us = 1000000u / u->refresh_hz;
+    uint32_t need = stats->samples - stats->samples / 100;
+    uint32_t cum = 0;
+    for (int bin = 0; bin < DMX_STATS_HIST_BINS; bin++) {
+        cum += stats->hist[bin];
+        if (cum >= need) {
+            stats->period_p99_us = stats_hist_edges[bin]
+                                       ? nominal_us + stats_hist_edges[bin]
+                                       : stats->period_max_us;
+            break;
+        }
+    }
 }
 
-void dmx_send_frame_now(void)
+uint16_t dmx_max_refresh(uint16_t slots, uint16_t break_us, uint16_t mab_us)
 {
-    /* Not needed in simple version - thread handles everything */
-    rt_kprintf("[DMX] Manual frame trigger (not needed in thread mode)\n");
+    /* 44µs per byte at 250kbaud (11 bits), start code included.
+     * Rounded division so the canonical 512-slot config yields 44 Hz. */
+    uint32_t frame_us = (uint32_t)break_us + mab_us + ((uint32_t)slots + 1) * 44;
+
+    return (uint16_t)((1000000 + frame_us / 2) / frame_us);
 }
 
-int dmx_set_timing(uint16_t refresh_hz, uint16_t break_us, uint16_t mab_us)
+int dmx_set_timing(uint8_t universe, uint16_t refresh_hz, uint16_t break_us,
+                   uint16_t mab_us, uint16_t slots)
 {
+    dmx_universe_t *u = uni_get(universe);
+
+    if (!u) {
+        return -1;
+    }
+
     /* Validate ranges (0 = unchanged)
      * DMX512 spec (ANSI E1.11):
-     *   Frame rate: Any rate is valid, max ~44Hz with 512 channels
+     *   Frame rate: Any rate is valid; the max derives from the frame
+     *               length (~44Hz with 512 slots, ~290Hz with 64)
      *   BREAK: TX min 92µs, RX must accept 88µs
      *   MAB:   TX min 12µs, RX must accept 8µs
+     *   Slots: 1-512 channels per frame
      */
-    if (refresh_hz != 0) {
-        if (refresh_hz < DMX_REFRESH_HZ_MIN || refresh_hz > DMX_REFRESH_HZ_MAX) {
-            rt_kprintf("[DMX] ERR: Invalid refresh %d Hz (range: %d-%d)\n",
-                       refresh_hz, DMX_REFRESH_HZ_MIN, DMX_REFRESH_HZ_MAX);
-            return -1;
-        }
-        g_dmx.refresh_hz = refresh_hz;
-    }
-
     if (break_us != 0) {
         if (break_us < DMX_BREAK_US_MIN || break_us > DMX_BREAK_US_MAX) {
             rt_kprintf("[DMX] ERR: Invalid BREAK %dµs (range: %d-%d)\n",
                         break_us, DMX_BREAK_US_MIN, DMX_BREAK_US_MAX);
             return -1;
         }
-        g_dmx.break_us = break_us;
+        u->break_us = break_us;
     }
 
     if (mab_us != 0) {
         if (mab_us < DMX_MAB_US_MIN || mab_us > DMX_MAB_US_MAX) {
-            rt_kprintf("[DMX] ERR: Invalid MAB %dµs (range: %d-%d)\n", 
+            rt_kprintf("[DMX] ERR: Invalid MAB %dµs (range: %d-%d)\n",
                         mab_us, DMX_MAB_US_MIN, DMX_MAB_US_MAX);
             return -1;
         }
-        g_dmx.mab_us = mab_us;
+        u->mab_us = mab_us;
+    }
+
+    if (slots != 0) {
+        if (slots < DMX_SLOTS_MIN || slots > DMX_SLOTS_MAX) {
+            rt_kprintf("[DMX] ERR: Invalid slots %d (range: %d-%d)\n",
+                        slots, DMX_SLOTS_MIN, DMX_SLOTS_MAX);
+            return -1;
+        }
+        u->slots = slots;
+    }
+
+    /* Refresh is bounded by what the configured frame fits on the wire */
+    uint16_t max_hz = dmx_max_refresh(u->slots, u->break_us, u->mab_us);
+
+    if (refresh_hz != 0) {
+        if (refresh_hz < DMX_REFRESH_HZ_MIN || refresh_hz > max_hz) {
+            rt_kprintf("[DMX] ERR: Invalid refresh %d Hz (range: %d-%d for %d slots)\n",
+                       refresh_hz, DMX_REFRESH_HZ_MIN, max_hz, u->slots);
+            return -1;
+        }
+        u->refresh_hz = refresh_hz;
+    } else if (u->refresh_hz > max_hz) {
+        /* A longer frame may no longer sustain the old rate - clamp */
+        rt_kprintf("[DMX] WARN: Refresh clamped %d -> %d Hz for %d slots\n",
+                   u->refresh_hz, max_hz, u->slots);
+        u->refresh_hz = max_hz;
+    }
+
+    rt_kprintf("[DMX] Universe %d timing updated: %d Hz, BREAK=%dµs, MAB=%dµs, %d slots\n",
+               universe, u->refresh_hz, u->break_us, u->mab_us, u->slots);
+
+    return 0;
+}
+
+int dmx_set_adaptive(uint8_t universe, uint16_t keepalive_hz,
+                     uint16_t idle_frames)
+{
+    dmx_universe_t *u = uni_get(universe);
+
+    if (!u) {
+        return -1;
+    }
+
+    if (keepalive_hz == 0) {
+        u->adaptive = false;
+        u->throttled = false;
+        u->unchanged_frames = 0;
+        rt_kprintf("[DMX] Adaptive refresh disabled (universe %d)\n", universe);
+        return 0;
     }
 
-    rt_kprintf("[DMX] Timing updated: %d Hz, BREAK=%dµs, MAB=%dµs\n",
-               g_dmx.refresh_hz, g_dmx.break_us, g_dmx.mab_us);
+    if (keepalive_hz > u->refresh_hz) {
+        rt_kprintf("[DMX] Keep-alive rate %d Hz exceeds refresh rate %d Hz\n",
+                   keepalive_hz, u->refresh_hz);
+        return -1;
+    }
+
+    u->keepalive_hz = keepalive_hz;
+    u->adapt_idle = idle_frames ? idle_frames : DMX_ADAPT_IDLE_FRAMES_DEFAULT;
+    u->unchanged_frames = 0;
+    u->throttled = false;
+    u->adaptive = true;
+
+    rt_kprintf("[DMX] Adaptive refresh: u%d drops to %d Hz after %d unchanged frames\n",
+               universe, u->keepalive_hz, u->adapt_idle);
 
     return 0;
 }
 
-void dmx_get_timing(uint16_t *refresh_hz, uint16_t *break_us, uint16_t *mab_us)
+void dmx_get_timing(uint8_t universe, uint16_t *refresh_hz, uint16_t *break_us,
+                    uint16_t *mab_us, uint16_t *slots)
 {
+    dmx_universe_t *u = uni_get(universe);
+
+    if (!u) {
+        return;
+    }
+
     if (refresh_hz) {
-        *refresh_hz = g_dmx.refresh_hz;
+        *refresh_hz = u->refresh_hz;
     }
     if (break_us) {
-        *break_us = g_dmx.break_us;
+        *break_us = u->break_us;
     }
     if (mab_us) {
-        *mab_us = g_dmx.mab_us;
+        *mab_us = u->mab_us;
+    }
+    if (slots) {
+        *slots = u->slots;
+    }
+}
+
+int dmx_get_universe(uint8_t universe, uint16_t offset, uint16_t count,
+                     dmx_universe_payload_t *out)
+{
+    dmx_universe_t *u = uni_get(universe);
+
+    if (!u || !out || offset >= DMX_UNIVERSE_SIZE) {
+        return -RT_ERROR;
+    }
+
+    if (count > DMX_UNIVERSE_CHUNK_MAX) {
+        count = DMX_UNIVERSE_CHUNK_MAX;
     }
+    if (offset + count > DMX_UNIVERSE_SIZE) {
+        count = DMX_UNIVERSE_SIZE - offset;
+    }
+
+    out->enabled = u->enabled ? 1 : 0;
+    out->rsvd = 0;
+    out->refresh_hz = u->refresh_hz;
+    out->break_us = u->break_us;
+    out->mab_us = u->mab_us;
+    out->slots = u->slots;
+    out->offset = offset;
+    out->count = count;
+
+    /* Snapshot the writer-side view so a readback right after a set
+     * command reflects that command */
+    rt_mutex_take(u->wr_mutex, RT_WAITING_FOREVER);
+    rt_memcpy(out->channels, &u->bufs[u->wr_idx][offset], count);
+    rt_mutex_release(u->wr_mutex);
+
+    return RT_EOK;
 }
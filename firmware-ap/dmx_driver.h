@@ -10,6 +10,7 @@
 
 #include <stdint.h>
 #include <stdbool.h>
+#include "dmx_protocol.h"   /* dmx_stats_payload_t, DMX_STATS_* */
 
 /* ============================================================================
  * DMX512 Constants
@@ -18,6 +19,14 @@
 #define DMX_UNIVERSE_SIZE    512    /* 512 channels standard DMX512 */
 #define DMX_FRAME_SIZE       513    /* Start code (1) + channels (512) */
 
+/*
+ * Number of DMX outputs driven from CPU2. Universe 0 is the original
+ * UART3 output; additional universes map to spare UARTs (see the wiring
+ * table in dmx_driver.c) and need matching iomux + AMP dtsi routing.
+ * A universe whose UART is absent at boot is simply skipped.
+ */
+#define DMX_NUM_UNIVERSES    2
+
 /* DMX512 break/MAB timing (microseconds) */
 #define DMX_BREAK_US_DEFAULT 150    /* Break: 88-200µs (using 100µs) */
 #define DMX_BREAK_US_MIN     88
@@ -26,10 +35,18 @@
 #define DMX_MAB_US_MIN       8
 #define DMX_MAB_US_MAX       100
 
+/* Universe length (slots per frame). DMX512 allows short frames at
+ * proportionally higher rates - 64 slots refresh at ~290 Hz. */
+#define DMX_SLOTS_MIN        1
+#define DMX_SLOTS_MAX        512
+#define DMX_SLOTS_DEFAULT    512
+
 /* Frame rate */
 #define DMX_REFRESH_HZ_DEFAULT  44  /* Default: 44 Hz = 22.7ms per frame */
 #define DMX_REFRESH_HZ_MIN      1   /* Minimum: 1 Hz */
-#define DMX_REFRESH_HZ_MAX      44  /* Maximum: 44 Hz (limited by 512ch frame time) */
+#define DMX_REFRESH_HZ_MAX      44  /* Maximum at the full 512 slots; the
+                                       actual bound derives from the
+                                       configured slots (dmx_max_refresh) */
 
 /* ============================================================================
  * DMX Driver Status Structure
@@ -40,108 +57,346 @@ typedef struct {
     uint32_t frame_count;   /* Total frames transmitted */
     uint32_t fps;           /* Current FPS × 100 (e.g., 4400 = 44.00 Hz) */
     uint32_t errors;        /* Error count */
+    uint16_t effective_hz;  /* Rate currently paced (keep-alive when idle) */
+    bool throttled;         /* Adaptive mode is in keep-alive state */
 } dmx_driver_status_t;
 
 /* ============================================================================
  * DMX API
+ *
+ * All calls address one universe (0 to DMX_NUM_UNIVERSES-1). An invalid
+ * or absent universe returns -1 / is ignored for void calls.
  * ============================================================================ */
 
 /**
- * Initialize DMX driver
+ * Initialize DMX driver (all universes)
  *
- * Sets up UART3, DMA, and timer
+ * Sets up the UARTs, TX interrupts, and the shared TX thread. Universes
+ * whose UART is not present are skipped with a warning.
  *
  * Returns:
- *   0 on success
+ *   0 on success (at least universe 0 up)
  *   -1 on error
  */
 int dmx_init(void);
 
 /**
- * Enable DMX transmission
+ * Enable DMX transmission on one universe
  *
- * Starts periodic frame transmission at 44 Hz
+ * Args:
+ *   universe: Universe index (0 to DMX_NUM_UNIVERSES-1)
  */
-void dmx_enable(void);
+void dmx_enable(uint8_t universe);
 
 /**
- * Disable DMX transmission
+ * Disable DMX transmission on one universe
  *
- * Stops frame transmission
+ * Args:
+ *   universe: Universe index
  */
-void dmx_disable(void);
+void dmx_disable(uint8_t universe);
 
 /**
  * Set single DMX channel
  *
  * Args:
+ *   universe: Universe index
  *   channel: Channel number (0-511)
  *   value: Channel value (0-255)
  *
  * Returns:
  *   0 on success
- *   -1 if channel out of range
+ *   -1 if universe or channel out of range
  */
-int dmx_set_channel(uint16_t channel, uint8_t value);
+int dmx_set_channel(uint8_t universe, uint16_t channel, uint8_t value);
 
 /**
  * Set multiple DMX channels
  *
  * Args:
+ *   universe: Universe index
  *   start: First channel (0-511)
  *   values: Array of channel values
  *   count: Number of channels to set
  *
  * Returns:
  *   0 on success
- *   -1 if range invalid
+ *   -1 if universe or range invalid
+ */
+int dmx_set_channels(uint8_t universe, uint16_t start, const uint8_t *values, uint16_t count);
+
+/**
+ * Set N non-contiguous DMX channels
+ *
+ * Args:
+ *   universe: Universe index
+ *   pairs: Raw pair array, 3 bytes per entry: [channel:2 LE][value:1]
+ *   count: Number of pairs
+ *
+ * Returns:
+ *   0 on success
+ *   -1 if universe or any channel out of range (no channel modified)
  */
-int dmx_set_channels(uint16_t start, const uint8_t *values, uint16_t count);
+int dmx_set_sparse(uint8_t universe, const uint8_t *pairs, uint16_t count);
 
 /**
- * Blackout - Set all channels to 0
+ * Start a fade on one universe
+ *
+ * The TX thread interpolates from the current output to the targets
+ * over duration_ms, one step per frame. A new fade replaces the active
+ * one (starting from the current output); dmx_blackout() cancels it.
+ *
+ * Args:
+ *   universe: Universe index
+ *   start: First channel (0-511)
+ *   targets: Target values, one per channel
+ *   count: Number of channels to fade
+ *   duration_ms: Fade duration (0 = apply immediately, max 60000)
+ *   easing: DMX_FADE_LINEAR or DMX_FADE_EASE (dmx_protocol.h)
+ *
+ * Returns:
+ *   0 on success
+ *   -1 if universe, range, duration or easing invalid
  */
-void dmx_blackout(void);
+int dmx_fade_start(uint8_t universe, uint16_t start, const uint8_t *targets,
+                   uint16_t count, uint16_t duration_ms, uint8_t easing);
 
 /**
- * Get DMX status
+ * Stage channels into the pending buffer of one universe
+ *
+ * Staged values do not touch the live frame until dmx_commit(). Repeated
+ * stages accumulate; later writes to the same channel win.
  *
  * Args:
+ *   universe: Universe index
+ *   start: First channel (0-511)
+ *   values: Array of channel values
+ *   count: Number of channels to stage
+ *
+ * Returns:
+ *   0 on success
+ *   -1 if universe or range invalid
+ */
+int dmx_stage_channels(uint8_t universe, uint16_t start, const uint8_t *values,
+                       uint16_t count);
+
+/**
+ * Commit staged channels - they appear in the next transmitted frame
+ *
+ * Folds everything staged since the last commit into the live frame in
+ * one atomic publish, so a multi-channel cue never tears across frame
+ * boundaries. A commit with nothing staged is a no-op.
+ *
+ * Args:
+ *   universe: Universe index
+ *
+ * Returns:
+ *   0 on success
+ *   -1 if universe invalid
+ */
+int dmx_commit(uint8_t universe);
+
+/**
+ * Store the current output of one universe into a scene slot
+ *
+ * Snapshots the 512 live channel values into the scene table in
+ * reserved DDR (DMX_SCENE_PHYS_ADDR) and marks the slot valid. Scene
+ * slots are global - any universe can store into or recall from any
+ * slot. Scenes survive a firmware restart but not a power cycle.
+ *
+ * Args:
+ *   universe: Universe to snapshot
+ *   scene: Scene slot (0 to DMX_SCENE_COUNT-1)
+ *
+ * Returns:
+ *   0 on success
+ *   -1 if universe or slot invalid
+ */
+int dmx_scene_store(uint8_t universe, uint8_t scene);
+
+/**
+ * Recall a stored scene onto one universe
+ *
+ * With duration_ms == 0 the scene lands in one atomic full-frame
+ * publish (never a torn frame). With duration_ms > 0 the output
+ * crossfades from the current look to the scene via the fade engine.
+ *
+ * Args:
+ *   universe: Universe to drive
+ *   scene: Scene slot (0 to DMX_SCENE_COUNT-1)
+ *   duration_ms: Crossfade duration, 0 = instant (max DMX_FADE_MAX_MS)
+ *   easing: DMX_FADE_LINEAR or DMX_FADE_EASE (ignored when instant)
+ *
+ * Returns:
+ *   0 on success
+ *   -1 if universe/slot invalid or the slot has never been stored
+ */
+int dmx_scene_recall(uint8_t universe, uint8_t scene, uint16_t duration_ms,
+                     uint8_t easing);
+
+/**
+ * Blackout - Set all channels of one universe to 0
+ *
+ * Also discards staged-but-uncommitted data and cancels an active fade.
+ *
+ * Args:
+ *   universe: Universe index
+ */
+void dmx_blackout(uint8_t universe);
+
+/**
+ * Count one protocol-level error against a universe
+ *
+ * Used by the RPMSG layer for failures that have no response packet
+ * (e.g. rejected NO_ACK commands) so they still show up in status/stats
+ *
+ * Args:
+ *   universe: Universe index
+ */
+void dmx_count_error(uint8_t universe);
+
+/**
+ * Get DMX status for one universe
+ *
+ * Args:
+ *   universe: Universe index
  *   status: Pointer to status structure to fill
  */
-void dmx_get_status(dmx_driver_status_t *status);
+void dmx_get_status(uint8_t universe, dmx_driver_status_t *status);
+
+/**
+ * Get high-resolution frame timing stats for one universe
+ *
+ * BREAK-to-BREAK periods measured with the 24MHz system timer:
+ * min/max/mean/p99 plus a deviation histogram (DMX_STATS_HIST_EDGES).
+ * Accumulates from the last enable. An invalid universe yields zeros.
+ *
+ * Args:
+ *   universe: Universe index
+ *   stats: Payload structure to fill
+ */
+void dmx_get_stats(uint8_t universe, dmx_stats_payload_t *stats);
+
+/**
+ * Arm the wire-level capture on the universe-1 UART RX
+ *
+ * The RX pin must be loopback-wired to the universe-0 TX pin (test
+ * jig). Collects BREAK+MAB, slot and frame period timing for the given
+ * number of frames, then stops itself; dmx_capture_report() reads the
+ * results. See the Capture Mode section in dmx_driver.c for what the
+ * RX side can and cannot resolve.
+ *
+ * Args:
+ *   frames: Full frames to capture (1 to DMX_CAPTURE_MAX_FRAMES)
+ *
+ * Returns:
+ *   0 on success
+ *   -1 if the capture UART is absent, transmitting, already capturing,
+ *      or frames is out of range
+ */
+int dmx_capture_start(uint16_t frames);
 
 /**
- * Send one DMX frame immediately (manual trigger)
+ * Read the capture results (valid mid-run; running=1 until done)
  *
- * For testing/debugging
+ * Args:
+ *   stats: Payload structure to fill
+ *
+ * Returns:
+ *   0 on success
+ *   -1 if the capture UART is absent
  */
-void dmx_send_frame_now(void);
+int dmx_capture_report(dmx_capture_payload_t *stats);
 
 /**
- * Set DMX timing (frame rate, BREAK, MAB)
+ * Get the maximum refresh rate for a given frame configuration
  *
- * Use 0 for any parameter to keep current value unchanged.
+ * Derived from the wire time: BREAK + MAB + (slots + start code) ×
+ * 44µs/byte at 250kbaud.
  *
  * Args:
- *   refresh_hz: Frame rate in Hz (1-44, 0=unchanged)
+ *   slots: Channels per frame (1-512)
+ *   break_us: BREAK duration in microseconds
+ *   mab_us: MAB duration in microseconds
+ *
+ * Returns: Maximum frame rate in Hz
+ */
+uint16_t dmx_max_refresh(uint16_t slots, uint16_t break_us, uint16_t mab_us);
+
+/**
+ * Set DMX timing (frame rate, BREAK, MAB, slots) for one universe
+ *
+ * Use 0 for any parameter to keep current value unchanged. The refresh
+ * rate is validated against the rate the configured frame length can
+ * sustain on the wire (dmx_max_refresh).
+ *
+ * Args:
+ *   universe: Universe index
+ *   refresh_hz: Frame rate in Hz (1-max for slots, 0=unchanged)
  *   break_us: BREAK duration in microseconds (88-1000, 0=unchanged)
  *   mab_us: MAB duration in microseconds (8-100, 0=unchanged)
+ *   slots: Channels per frame (1-512, 0=unchanged)
  *
  * Returns:
  *   0 on success
- *   -1 if invalid range
+ *   -1 if universe or range invalid
  */
-int dmx_set_timing(uint16_t refresh_hz, uint16_t break_us, uint16_t mab_us);
+int dmx_set_timing(uint8_t universe, uint16_t refresh_hz, uint16_t break_us,
+                   uint16_t mab_us, uint16_t slots);
 
 /**
- * Get current DMX timing
+ * Configure adaptive refresh (opt-in keep-alive throttling)
+ *
+ * With keepalive_hz > 0 the universe transmits at its configured
+ * refresh rate while data is changing and drops to keepalive_hz after
+ * idle_frames consecutive unchanged frames; the first write (RPMSG,
+ * shared-memory publish or fade) snaps it back to full rate.
  *
  * Args:
+ *   universe: Universe index
+ *   keepalive_hz: Idle refresh rate (1 to refresh_hz), 0 = disable
+ *   idle_frames: Unchanged frames before throttling
+ *                (0 = DMX_ADAPT_IDLE_FRAMES_DEFAULT)
+ *
+ * Returns:
+ *   0 on success
+ *   -1 if universe invalid or keepalive_hz exceeds the refresh rate
+ */
+int dmx_set_adaptive(uint8_t universe, uint16_t keepalive_hz,
+                     uint16_t idle_frames);
+
+/**
+ * Get current DMX timing for one universe
+ *
+ * Args:
+ *   universe: Universe index
  *   refresh_hz: Pointer to store frame rate (can be NULL)
  *   break_us: Pointer to store BREAK duration (can be NULL)
  *   mab_us: Pointer to store MAB duration (can be NULL)
+ *   slots: Pointer to store channels per frame (can be NULL)
+ */
+void dmx_get_timing(uint8_t universe, uint16_t *refresh_hz, uint16_t *break_us,
+                    uint16_t *mab_us, uint16_t *slots);
+
+/**
+ * Read back one universe's state for warm-restart recovery
+ *
+ * Fills the config header (enable flag + timing) and one chunk of live
+ * channel values, so a client that reconnects after a Linux reboot can
+ * resynchronize instead of blacking out and replaying the show.
+ *
+ * Args:
+ *   universe: Universe index
+ *   offset: First channel of the chunk (0-511)
+ *   count: Channels requested (clamped to DMX_UNIVERSE_CHUNK_MAX and
+ *          to the end of the universe)
+ *   out: Payload to fill (must have room for the clamped chunk)
+ *
+ * Returns:
+ *   0 on success
+ *   -1 if universe or offset invalid
  */
-void dmx_get_timing(uint16_t *refresh_hz, uint16_t *break_us, uint16_t *mab_us);
+int dmx_get_universe(uint8_t universe, uint16_t offset, uint16_t count,
+                     dmx_universe_payload_t *out);
 
 #endif /* DMX_DRIVER_H */
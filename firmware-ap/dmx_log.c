@@ -0,0 +1,160 @@
+/* SPDX-License-Identifier: BSD-3-Clause */
+/*
+ * Copyright (c) 2025 Pierre Jay
+ *
+ * Deferred logging - ring buffer + low-priority drain thread.
+ */
+
+#include <rtthread.h>
+#include <stdlib.h>
+#include "dmx_log.h"
+
+/* ============================================================================
+ * Configuration
+ * ============================================================================ */
+
+#define DMX_LOG_RECORDS     128     /* Ring capacity (power of two) */
+
+#define LOG_THREAD_STACK    1024
+/* Below the TX thread, the RX thread and the shell - drains only when
+ * nothing latency-sensitive wants the CPU */
+#define LOG_THREAD_PRIO     (RT_THREAD_PRIORITY_MAX - 2)
+
+/* ============================================================================
+ * Ring State
+ * ============================================================================ */
+
+typedef struct {
+    rt_tick_t tick;             /* When the record was appended */
+    uint8_t level;              /* DMX_LOG_* */
+    const char *fmt;            /* Format string (literal in .rodata) */
+    uint32_t args[3];           /* Integer format arguments */
+} dmx_log_rec_t;
+
+static dmx_log_rec_t g_ring[DMX_LOG_RECORDS];
+static volatile uint32_t g_head;        /* Next slot to write (producers) */
+static volatile uint32_t g_tail;        /* Next slot to read (drain thread) */
+static volatile uint32_t g_dropped;     /* Records lost to a full ring */
+static volatile uint8_t g_level = DMX_LOG_INFO;
+
+/* ============================================================================
+ * Hot-Path Append
+ * ============================================================================ */
+
+void dmx_log(uint8_t level, const char *fmt,
+             uint32_t a0, uint32_t a1, uint32_t a2)
+{
+    /* Filter at the call site - a discarded record costs one compare */
+    if (level > g_level) {
+        return;
+    }
+
+    /*
+     * Slot claim. Producers run in several thread contexts, so the
+     * claim+fill must not interleave; a few-cycle IRQ-off window is the
+     * cheapest way to get that on a single core and, unlike a mutex,
+     * can never block or invert priorities.
+     */
+    rt_base_t irq = rt_hw_interrupt_disable();
+
+    if (g_head - g_tail >= DMX_LOG_RECORDS) {
+        g_dropped++;
+        rt_hw_interrupt_enable(irq);
+        return;
+    }
+
+    dmx_log_rec_t *rec = &g_ring[g_head % DMX_LOG_RECORDS];
+    rec->tick = rt_tick_get();
+    rec->level = level;
+    rec->fmt = fmt;
+    rec->args[0] = a0;
+    rec->args[1] = a1;
+    rec->args[2] = a2;
+
+    /* Record must be complete before the drain thread can see it */
+    __asm__ volatile("dsb sy" ::: "memory");
+    g_head++;
+
+    rt_hw_interrupt_enable(irq);
+}
+
+void dmx_log_set_level(uint8_t level)
+{
+    if (level > DMX_LOG_DEBUG) {
+        level = DMX_LOG_DEBUG;
+    }
+    g_level = level;
+}
+
+uint8_t dmx_log_get_level(void)
+{
+    return g_level;
+}
+
+/* ============================================================================
+ * Drain Thread
+ * ============================================================================ */
+
+static void dmx_log_thread_entry(void *parameter)
+{
+    static const char level_ch[] = { 'E', 'W', 'I', 'D' };
+    uint32_t dropped_seen = 0;
+
+    while (1) {
+        while (g_tail != g_head) {
+            dmx_log_rec_t *rec = &g_ring[g_tail % DMX_LOG_RECORDS];
+
+            /* Extra args beyond the format's conversions are ignored */
+            rt_kprintf("[%u %c] ", (unsigned)rec->tick, level_ch[rec->level]);
+            rt_kprintf(rec->fmt, rec->args[0], rec->args[1], rec->args[2]);
+            rt_kprintf("\n");
+
+            g_tail++;
+        }
+
+        /* Surface losses once per burst, not per record */
+        if (g_dropped != dropped_seen) {
+            rt_kprintf("[LOG] %u records dropped (ring full)\n",
+                       (unsigned)(g_dropped - dropped_seen));
+            dropped_seen = g_dropped;
+        }
+
+        rt_thread_mdelay(10);
+    }
+}
+
+/* ============================================================================
+ * Init + Shell Verb
+ * ============================================================================ */
+
+int dmx_log_init(void)
+{
+    rt_thread_t tid = rt_thread_create("dmx_log", dmx_log_thread_entry,
+                                       RT_NULL, LOG_THREAD_STACK,
+                                       LOG_THREAD_PRIO, 10);
+    if (tid == RT_NULL) {
+        rt_kprintf("[LOG] ERROR: Failed to create drain thread\n");
+        return -RT_ERROR;
+    }
+    rt_thread_startup(tid);
+
+    return RT_EOK;
+}
+
+#ifdef RT_USING_FINSH
+#include <finsh.h>
+
+static void dmx_loglevel(int argc, char **argv)
+{
+    if (argc < 2) {
+        rt_kprintf("Log level: %d (dropped: %u)\n",
+                   dmx_log_get_level(), (unsigned)g_dropped);
+        rt_kprintf("Usage: dmx_loglevel <0=err 1=warn 2=info 3=debug>\n");
+        return;
+    }
+
+    dmx_log_set_level((uint8_t)atoi(argv[1]));
+    rt_kprintf("Log level set to %d\n", dmx_log_get_level());
+}
+MSH_CMD_EXPORT(dmx_loglevel, Set DMX log verbosity(0 = err..3 = debug));
+#endif /* RT_USING_FINSH */
@@ -0,0 +1,79 @@
+/* SPDX-License-Identifier: BSD-3-Clause */
+/*
+ * Copyright (c) 2025 Pierre Jay
+ *
+ * Deferred logging for the DMX firmware hot path.
+ *
+ * rt_kprintf() bit-bangs characters to UART4 at 115200 baud - one
+ * diagnostic line costs more than the command it describes. Hot-path
+ * code appends a fixed-size binary record to a ring instead
+ * (microseconds, never blocks); a low-priority drain thread formats the
+ * records and emits them to the console when the CPU has nothing better
+ * to do. Under streaming load the ring fills faster than it drains and
+ * records are dropped (counted), which is the right trade: diagnostics
+ * must never stall command dispatch.
+ */
+
+#ifndef DMX_LOG_H
+#define DMX_LOG_H
+
+#include <stdint.h>
+
+/* ============================================================================
+ * Verbosity Levels
+ * ============================================================================ */
+
+#define DMX_LOG_ERROR   0   /* Failures (always of interest) */
+#define DMX_LOG_WARN    1   /* Recoverable anomalies */
+#define DMX_LOG_INFO    2   /* Per-command traffic (default) */
+#define DMX_LOG_DEBUG   3   /* Everything, incl. per-packet RX/TX */
+
+/* ============================================================================
+ * Log API
+ * ============================================================================ */
+
+/**
+ * Initialize the log ring and start the drain thread
+ *
+ * Returns:
+ *   0 on success
+ *   -1 on error (records are still accepted, just never drained)
+ */
+int dmx_log_init(void);
+
+/**
+ * Append one log record (hot-path safe, never blocks)
+ *
+ * fmt must be a string literal (the ring stores the pointer, not a
+ * copy) with at most three integer conversions; a0-a2 are its
+ * arguments, pass 0 for unused ones. Records above the current
+ * verbosity are discarded at the call site.
+ *
+ * Args:
+ *   level: DMX_LOG_ERROR..DMX_LOG_DEBUG
+ *   fmt: printf-style format (literal, integer args only)
+ *   a0, a1, a2: Format arguments
+ */
+void dmx_log(uint8_t level, const char *fmt,
+             uint32_t a0, uint32_t a1, uint32_t a2);
+
+/**
+ * Set runtime verbosity (also available as the `dmx_loglevel` MSH verb)
+ *
+ * Args:
+ *   level: DMX_LOG_ERROR..DMX_LOG_DEBUG
+ */
+void dmx_log_set_level(uint8_t level);
+
+/**
+ * Get current verbosity
+ */
+uint8_t dmx_log_get_level(void);
+
+/* Shorthand for the common levels */
+#define DMX_LOGE(fmt, a0, a1, a2) dmx_log(DMX_LOG_ERROR, fmt, a0, a1, a2)
+#define DMX_LOGW(fmt, a0, a1, a2) dmx_log(DMX_LOG_WARN, fmt, a0, a1, a2)
+#define DMX_LOGI(fmt, a0, a1, a2) dmx_log(DMX_LOG_INFO, fmt, a0, a1, a2)
+#define DMX_LOGD(fmt, a0, a1, a2) dmx_log(DMX_LOG_DEBUG, fmt, a0, a1, a2)
+
+#endif /* DMX_LOG_H */
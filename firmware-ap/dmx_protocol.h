@@ -19,9 +19,27 @@
 #define DMX_MAGIC_CMD       0xAA    /* Magic byte for commands (Linux → RT-Thread) */
 #define DMX_MAGIC_RESP      0xBB    /* Magic byte for responses (RT-Thread → Linux) */
 
+#define DMX_MAGIC_CMD_V2    0xAC    /* v2 command (adds sequence tag) */
+#define DMX_MAGIC_RESP_V2   0xBC    /* v2 response (echoes sequence tag) */
+
+#define DMX_MAGIC_EVENT     0xBE    /* Unsolicited push (RT-Thread → Linux) */
+
 #define DMX_MAX_CHANNELS    512     /* DMX512 standard */
 #define DMX_MAX_PAYLOAD     1024    /* Max payload size */
 
+/*
+ * Raw rpmsg_char transport (AP only)
+ *
+ * Besides the tty endpoint (/dev/ttyRPMSG0), the AP firmware exposes a
+ * second endpoint for clients that bypass the kernel tty layer via
+ * rpmsg_char: same protocol, but each rpmsg message is one complete
+ * packet, so there is no stream reassembly and no line discipline in
+ * the path. Create the endpoint with RPMSG_CREATE_EPT_IOCTL on
+ * /dev/rpmsg_ctrlX targeting DMX_RAW_EPT_ADDR.
+ */
+#define DMX_RAW_EPT_NAME    "dmx-raw"
+#define DMX_RAW_EPT_ADDR    0x3005U
+
 /* ============================================================================
  * Command Types
  * ============================================================================ */
@@ -34,8 +52,32 @@ typedef enum {
     CMD_DMX_BLACKOUT        = 0x05,  /* Set all channels to 0 */
     CMD_DMX_SET_TIMING      = 0x06,  /* Set FPS/BREAK/MAB timing (Hz/µs) */
     CMD_DMX_GET_TIMING      = 0x07,  /* Get current timing config */
+    CMD_DMX_BATCH           = 0x08,  /* Execute N sub-commands in one round trip */
+    CMD_DMX_SET_SPARSE      = 0x09,  /* Set N non-contiguous channels */
+    CMD_DMX_FADE            = 0x0A,  /* Fade a channel range to target values */
+    CMD_DMX_STAGE           = 0x0B,  /* Stage channels into the pending buffer */
+    CMD_DMX_COMMIT          = 0x0C,  /* Apply staged channels at the next frame */
+    CMD_DMX_GET_STATS       = 0x0D,  /* Get high-resolution frame timing stats */
+    CMD_DMX_CAPTURE         = 0x0E,  /* Wire-level RX capture (loopback timing check) */
+    CMD_DMX_SCENE_STORE     = 0x0F,  /* Snapshot the live frame into a scene slot */
+    CMD_DMX_SCENE_RECALL    = 0x10,  /* Apply a stored scene (optionally faded) */
+    CMD_DMX_GET_UNIVERSE    = 0x11,  /* Read back channels + config (recovery) */
+    CMD_DMX_SUBSCRIBE       = 0x12,  /* Push status events at a fixed rate */
 } dmx_cmd_type_t;
 
+/*
+ * Command flags (high bits of the cmd byte)
+ *
+ * DMX_CMD_FLAG_NO_ACK suppresses the response packet for write-type
+ * commands (SET_CHANNELS, SET_SPARSE, ENABLE, DISABLE, BLACKOUT,
+ * SET_TIMING, FADE, STAGE, COMMIT). At
+ * streaming rates the per-command ack doubles RPMSG traffic and blocks
+ * the sender for data it never uses; errors are counted in the firmware
+ * error counter instead and surface through the status/stats path.
+ */
+#define DMX_CMD_FLAG_NO_ACK  0x80    /* Fire-and-forget: no response sent */
+#define DMX_CMD_TYPE_MASK    0x7F    /* Command type without flag bits */
+
 /* ============================================================================
  * Response Status Codes
  * ============================================================================ */
@@ -47,6 +89,7 @@ typedef enum {
     STATUS_INVALID_CHECKSUM = 0x02,  /* Checksum mismatch */
     STATUS_INVALID_CMD      = 0x03,  /* Unknown command */
     STATUS_INVALID_LENGTH   = 0x04,  /* Invalid payload length */
+    STATUS_INVALID_UNIVERSE = 0x05,  /* Universe index out of range / not fitted */
 } dmx_status_t;
 
 /* ============================================================================
@@ -87,6 +130,50 @@ typedef struct {
     /* uint8_t checksum follows data */
 } __attribute__((packed)) dmx_resp_t;
 
+/*
+ * v2 command packet structure (Linux → RT-Thread)
+ *
+ * v1 has no correlation field, which forces the client to fully
+ * serialize: write, block for the response, write again. v2 adds a
+ * sequence tag that the firmware echoes back, so a client can keep
+ * several commands in flight and match responses by tag (~3x command
+ * throughput at ~100µs one-way RPMSG latency).
+ *
+ * Layout:
+ *   [magic:1] [cmd:1] [seq:1] [universe:1] [length:2] [data:N] [checksum:1]
+ *
+ * universe addresses one of the firmware's DMX outputs (0 = the
+ * original UART3 output; v1 framing has no such field and always
+ * addresses universe 0). An out-of-range universe is answered with
+ * STATUS_INVALID_UNIVERSE.
+ * CMD_DMX_BATCH keeps v1 framing (it aggregates its own response).
+ */
+typedef struct {
+    uint8_t magic;          /* Magic byte (0xAC) */
+    uint8_t cmd;            /* Command type (dmx_cmd_type_t) + flags */
+    uint8_t seq;            /* Sequence tag, echoed in the response */
+    uint8_t universe;       /* Target universe (0-based) */
+    uint16_t length;        /* Payload length (little-endian) */
+    uint8_t data[];         /* Variable payload */
+    /* uint8_t checksum follows data */
+} __attribute__((packed)) dmx_cmd_v2_t;
+
+/*
+ * v2 response packet structure (RT-Thread → Linux)
+ *
+ * Layout:
+ *   [magic:1] [status:1] [seq:1] [universe:1] [length:2] [data:N] [checksum:1]
+ */
+typedef struct {
+    uint8_t magic;          /* Magic byte (0xBC) */
+    uint8_t status;         /* Status code (dmx_status_t) */
+    uint8_t seq;            /* Sequence tag of the command answered */
+    uint8_t universe;       /* Universe the command addressed */
+    uint16_t length;        /* Payload length (little-endian) */
+    uint8_t data[];         /* Variable payload */
+    /* uint8_t checksum follows data */
+} __attribute__((packed)) dmx_resp_v2_t;
+
 /* ============================================================================
  * Command Payloads
  * ============================================================================ */
@@ -108,51 +195,409 @@ typedef struct {
     uint8_t values[];        /* Channel values (0-255) */
 } __attribute__((packed)) dmx_set_channels_t;
 
+/*
+ * CMD_DMX_SET_SPARSE payload
+ *
+ * Sets N non-contiguous channels in one command. SET_CHANNELS only
+ * expresses contiguous ranges, so scattered updates (typical fixture
+ * change: under 20 channels) cost either N round trips or one write
+ * spanning the whole range. 3 bytes per touched channel instead.
+ *
+ * Layout: N × pairs, payload length must be a multiple of 3
+ *   [channel:2] [value:1]
+ *
+ * Example: Set channel 1 to 255 and channel 57 to 10
+ *   0x00 0x00 0xFF  0x38 0x00 0x0A
+ */
+typedef struct {
+    uint16_t channel;       /* Channel (0-511, little-endian) */
+    uint8_t value;          /* Channel value (0-255) */
+} __attribute__((packed)) dmx_sparse_pair_t;
+
 /*
  * CMD_DMX_GET_STATUS response payload
  *
  * Returns current DMX status
  *
  * Layout:
- *   [enabled:1] [frame_count:4] [fps:4]
+ *   [enabled:1] [frame_count:4] [fps:4] [effective_hz:2] [throttled:1] [rsvd:1]
  */
 typedef struct {
     uint8_t enabled;        /* 0=disabled, 1=enabled */
     uint32_t frame_count;   /* Total frames sent (little-endian) */
     uint32_t fps;           /* Frames per second × 100 (e.g., 4400 = 44.00 Hz) */
+    uint16_t effective_hz;  /* Rate currently being paced (= refresh_hz, or
+                             * the keep-alive rate while throttled) */
+    uint8_t throttled;      /* 1 = adaptive mode is in keep-alive state */
+    uint8_t rsvd;           /* Alignment/reserved */
 } __attribute__((packed)) dmx_status_payload_t;
 
 /*
  * CMD_DMX_SET_TIMING payload
  *
- * Sets DMX timing: frame rate, BREAK, and MAB
+ * Sets DMX timing: frame rate, BREAK, MAB, and universe length (slots)
  * Use 0 for any field to keep current value unchanged.
  *
- * Frame rate: 1-44 Hz (DMX512 spec allows any rate, 44 Hz is max with 512 channels)
+ * Frame rate: max derives from the frame length - 44 Hz with the full
+ *   512 slots, proportionally more with shorter frames (DMX512 allows
+ *   short frames; e.g. 64 slots refresh at ~290 Hz)
  * BREAK: min 92µs (TX spec), receivers accept 88µs
  * MAB: min 12µs (TX spec), receivers accept 8µs
+ * Slots: channels transmitted per frame (1-512)
  *
- * Defaults: 44 Hz, BREAK=150µs, MAB=12µs
+ * Defaults: 44 Hz, BREAK=150µs, MAB=12µs, 512 slots
  *
  * Layout:
- *   [refresh_hz:2] [break_us:2] [mab_us:2]
+ *   [refresh_hz:2] [break_us:2] [mab_us:2] [slots:2]
+ *
+ * The slots field was appended later: a 6-byte payload (no slots) is
+ * still accepted and leaves the frame length unchanged, so older
+ * clients and the MCU firmware keep working.
  */
 typedef struct {
-    uint16_t refresh_hz;    /* Frame rate in Hz (1-44, 0=unchanged) */
+    uint16_t refresh_hz;    /* Frame rate in Hz (1-max for slots, 0=unchanged) */
     uint16_t break_us;      /* BREAK duration in µs (0=unchanged) */
     uint16_t mab_us;        /* MAB duration in µs (0=unchanged) */
+    uint16_t slots;         /* Channels per frame (1-512, 0=unchanged) */
 } __attribute__((packed)) dmx_timing_t;
 
+/* Payload length without the slots field (legacy 6-byte format) */
+#define DMX_TIMING_LEN_V1   6
+
+/*
+ * Extended SET_TIMING payload: adaptive refresh control (AP only)
+ *
+ * DMX receivers hold their last frame and only need a periodic refresh,
+ * so retransmitting an unchanged universe at the full rate wastes CPU2
+ * cycles and bus bandwidth. With keepalive_hz > 0 the firmware
+ * transmits at refresh_hz while data is changing, drops to keepalive_hz
+ * after idle_frames unchanged frames, and snaps back to full rate on
+ * the first write (or shared-memory publish, or fade step).
+ *
+ * Appended to the regular timing fields (which keep their 0=unchanged
+ * semantics):
+ *   [keepalive_hz:2]  keep-alive rate in Hz; 0 disables adaptive mode
+ *   [idle_frames:2]   unchanged frames before throttling (0 = default)
+ */
+typedef struct {
+    dmx_timing_t timing;    /* 0 = unchanged, as above */
+    uint16_t keepalive_hz;  /* >0 = enable adaptive mode at this idle rate */
+    uint16_t idle_frames;   /* Unchanged frames before throttling */
+} __attribute__((packed)) dmx_timing_adaptive_t;
+
+#define DMX_KEEPALIVE_HZ_DEFAULT    1    /* Idle refresh (1 frame/s) */
+#define DMX_ADAPT_IDLE_FRAMES_DEFAULT 88 /* ~2s of no changes at 44Hz */
+
 /*
  * CMD_DMX_GET_TIMING response payload
  *
  * Returns current timing configuration
  *
  * Layout:
- *   [refresh_hz:2] [break_us:2] [mab_us:2]
+ *   [refresh_hz:2] [break_us:2] [mab_us:2] [slots:2]
+ *
+ * (6 bytes from firmware that predates the slots field - the MCU.)
  */
 typedef dmx_timing_t dmx_timing_payload_t;
 
+/*
+ * CMD_DMX_BATCH payload
+ *
+ * Carries N sub-commands in a single packet so a composite sequence
+ * (e.g. set channels + set timing + status poll) costs one RPMSG round
+ * trip instead of N. Sub-commands execute in order.
+ *
+ * Command payload: concatenated sub-command entries
+ *   [cmd:1] [length:2] [data:N]          (no magic, no checksum - the
+ *                                         outer packet covers both)
+ *
+ * Response payload: one entry per sub-command, in order
+ *   [status:1] [length:2] [data:N]       (data = the sub-command's
+ *                                         normal response payload)
+ *
+ * The outer response status is STATUS_OK if the batch itself was well
+ * formed; per-sub-command results are in the entries.
+ */
+typedef struct {
+    uint8_t cmd;            /* Sub-command type (dmx_cmd_type_t) */
+    uint16_t length;        /* Sub-payload length (little-endian) */
+    uint8_t data[];         /* Sub-payload */
+} __attribute__((packed)) dmx_batch_entry_t;
+
+typedef struct {
+    uint8_t status;         /* Sub-command status (dmx_status_t) */
+    uint16_t length;        /* Sub-response length (little-endian) */
+    uint8_t data[];         /* Sub-response payload */
+} __attribute__((packed)) dmx_batch_result_t;
+
+/*
+ * CMD_DMX_FADE payload
+ *
+ * Fades a contiguous channel range from its current values to the given
+ * targets over duration_ms, interpolated per frame by the firmware TX
+ * thread. One command replaces hundreds of 44Hz SET_CHANNELS round
+ * trips and the steps are frame-locked on CPU2 instead of jittering
+ * through the Linux scheduler.
+ *
+ * One fade is active per universe; a new FADE replaces it (snapshotting
+ * the current output as the new starting point), BLACKOUT cancels it.
+ * duration_ms = 0 applies the targets immediately.
+ *
+ * Layout:
+ *   [channel_start:2] [duration_ms:2] [easing:1] [targets:N]
+ */
+#define DMX_FADE_LINEAR      0      /* Constant rate */
+#define DMX_FADE_EASE        1      /* Smoothstep (slow in/out) */
+#define DMX_FADE_MAX_MS      60000  /* Longest accepted fade */
+
+typedef struct {
+    uint16_t channel_start; /* First channel (0-511, little-endian) */
+    uint16_t duration_ms;   /* Fade duration (0 = immediate, max 60000) */
+    uint8_t easing;         /* DMX_FADE_LINEAR or DMX_FADE_EASE */
+    uint8_t targets[];      /* Target values, one per channel */
+} __attribute__((packed)) dmx_fade_t;
+
+/*
+ * CMD_DMX_GET_STATS response payload
+ *
+ * High-resolution frame timing telemetry. The firmware timestamps every
+ * BREAK with the 24MHz system timer and tracks the BREAK-to-BREAK
+ * period - the number a DMX receiver actually experiences, which the
+ * coarse tick-derived fps in GET_STATUS hides. Deviation from the
+ * nominal period (1e6 / refresh_hz) is binned into a histogram so
+ * jitter distribution, not just worst case, is visible remotely.
+ *
+ * Stats accumulate from enable (or re-enable) on; errors counts driver
+ * faults (TX-done timeouts, TX idle-wait timeouts, rejected NO_ACK
+ * commands). skipped counts frames dropped by UART fault recovery -
+ * a wedged UART is purged and reconfigured at the cost of exactly one
+ * frame, and this counter is how such stalls stay visible remotely.
+ *
+ * Layout:
+ *   [frame_count:4] [errors:4] [skipped:4] [period_min_us:4]
+ *   [period_max_us:4] [period_avg_us:4] [period_p99_us:4] [samples:4]
+ *   [hist:4×8]
+ */
+#define DMX_STATS_HIST_BINS  8
+
+/* Histogram bin upper edges: |period - nominal| deviation in µs.
+ * The last bin is open-ended (edge 0 = +inf). */
+#define DMX_STATS_HIST_EDGES { 50, 100, 200, 500, 1000, 2000, 5000, 0 }
+
+typedef struct {
+    uint32_t frame_count;   /* Total frames sent (little-endian) */
+    uint32_t errors;        /* Driver error count */
+    uint32_t skipped;       /* Frames dropped by UART fault recovery */
+    uint32_t period_min_us; /* Shortest BREAK-to-BREAK period seen */
+    uint32_t period_max_us; /* Longest BREAK-to-BREAK period seen */
+    uint32_t period_avg_us; /* Mean period */
+    uint32_t period_p99_us; /* 99th percentile (histogram bin bound) */
+    uint32_t samples;       /* Periods measured */
+    uint32_t hist[DMX_STATS_HIST_BINS]; /* Deviation histogram */
+} __attribute__((packed)) dmx_stats_payload_t;
+
+/*
+ * CMD_DMX_CAPTURE - wire-level timing capture (AP only)
+ *
+ * Validates what actually hits the wire, not what was commanded. The
+ * firmware listens on the universe-1 UART RX (loopback-wired to the
+ * universe-0 TX pin on the test jig) and timestamps break-detect and
+ * byte-complete events with the 24MHz system timer. No instruments
+ * needed - a production jig just loops TX back to RX.
+ *
+ * Measured per frame:
+ *   - BREAK+MAB: break-detect to start-code completion. The DW UART
+ *     flags a break after one full character time (44µs) low, and the
+ *     start code itself takes 44µs, so the two offsets cancel and the
+ *     delta is BREAK+MAB directly. The RX side cannot see the BREAK
+ *     rising edge, so BREAK and MAB are validated combined.
+ *   - Slot period: byte-to-byte completion deltas (44µs nominal);
+ *     |slot - 44µs| deviations binned with DMX_STATS_HIST_EDGES.
+ *   - Frame period: break-to-break delta.
+ *
+ * Request payload: [op:1] plus for START [frames:2 LE]
+ *   DMX_CAPTURE_OP_START: arm the RX capture for N frames (1-1000).
+ *     Fails if universe 1 is transmitting (the capture borrows its
+ *     UART) or a capture is already running.
+ *   DMX_CAPTURE_OP_REPORT: return dmx_capture_payload_t; valid
+ *     mid-run (running=1, counters so far).
+ *
+ * Capture always observes the universe-0 output; address universe 0.
+ */
+#define DMX_CAPTURE_OP_START    0x00
+#define DMX_CAPTURE_OP_REPORT   0x01
+#define DMX_CAPTURE_MAX_FRAMES  1000
+
+typedef struct {
+    uint8_t running;        /* 1 while the capture is still collecting */
+    uint8_t rsvd;           /* Pad */
+    uint16_t frames;        /* Full frames captured so far (little-endian) */
+    uint32_t bytes;         /* Data bytes received */
+    uint32_t errors;        /* Framing/overrun errors on the RX side */
+    uint32_t break_mab_min_us;  /* BREAK+MAB, shortest seen */
+    uint32_t break_mab_avg_us;  /* BREAK+MAB, mean */
+    uint32_t break_mab_max_us;  /* BREAK+MAB, longest seen */
+    uint32_t slot_min_us;   /* Byte-to-byte period, shortest */
+    uint32_t slot_avg_us;   /* Byte-to-byte period, mean */
+    uint32_t slot_max_us;   /* Byte-to-byte period, longest */
+    uint32_t period_min_us; /* BREAK-to-BREAK period, shortest */
+    uint32_t period_avg_us; /* BREAK-to-BREAK period, mean */
+    uint32_t period_max_us; /* BREAK-to-BREAK period, longest */
+    uint32_t hist[DMX_STATS_HIST_BINS]; /* |slot - 44µs| deviation histogram */
+} __attribute__((packed)) dmx_capture_payload_t;
+
+/*
+ * CMD_DMX_STAGE / CMD_DMX_COMMIT
+ *
+ * Direct channel writes become visible at whatever frame boundary comes
+ * next, so a cue spanning several outputs (the AP universes on
+ * ttyRPMSG0 and the MCU on ttyRPMSG1) visibly tears across them. STAGE
+ * lands channel data in a pending buffer without touching the live
+ * frame; COMMIT folds everything staged into the live frame at the next
+ * frame boundary. Stage the bulk data per target ahead of time, then
+ * fire the tiny COMMIT packets back to back - cue application latency
+ * collapses to one small round trip per target.
+ *
+ * STAGE payload: same layout as CMD_DMX_SET_CHANNELS
+ *   [channel_start:2] [values:N]
+ * Repeated STAGEs accumulate (later writes to the same channel win).
+ *
+ * COMMIT payload: empty. A COMMIT with nothing staged is a no-op
+ * (STATUS_OK), so a cue engine can broadcast it unconditionally.
+ * BLACKOUT discards any staged-but-uncommitted data.
+ */
+
+/*
+ * CMD_DMX_SCENE_STORE / CMD_DMX_SCENE_RECALL (AP only)
+ *
+ * Preset looks executed on the coprocessor. Without scenes, applying a
+ * look means streaming up to 512 channel values from Linux every time;
+ * with them, the values cross the link once (or are still warm from a
+ * previous run) and a recall is a tiny command that completes within
+ * one frame period.
+ *
+ * STORE payload: [scene:1]
+ *   Snapshots the addressed universe's current output into the slot.
+ *   Build the look with SET_CHANNELS/FADE first, then store it.
+ *
+ * RECALL payload: [scene:1] or [scene:1] [duration_ms:2] [easing:1]
+ *   Applies the slot to the addressed universe - atomically (one
+ *   publish) in the short form, or through the fade engine with the
+ *   long form. Recalling an empty slot fails with STATUS_ERROR.
+ *
+ * The table lives in the AMP reserved DDR page below the channel
+ * mirror, so stored scenes survive a firmware or gateway restart (not
+ * a power cycle). Slots are global, not per universe - a scene is just
+ * 512 values and can be recalled onto any universe.
+ */
+#define DMX_SCENE_COUNT      16
+#define DMX_SCENE_PHYS_ADDR  0x03BE0000UL
+#define DMX_SCENE_MAGIC      0x444D5853UL   /* "DMXS" */
+
+typedef struct {
+    uint32_t magic;         /* DMX_SCENE_MAGIC once initialized */
+    uint32_t valid_mask;    /* Bit n set = slot n holds a scene */
+    uint32_t rsvd[2];       /* Pad header to 16 bytes */
+    uint8_t scenes[DMX_SCENE_COUNT][DMX_MAX_CHANNELS];
+} __attribute__((packed)) dmx_scene_table_t;
+
+/*
+ * CMD_DMX_GET_UNIVERSE (AP only)
+ *
+ * Full state readback for warm-restart recovery. When Linux reboots the
+ * firmware keeps transmitting, but a freshly started client knows
+ * nothing about the running output. This command returns the enable
+ * flag, the timing configuration and the live channel values in one
+ * query, so recovery costs a couple of round trips instead of a
+ * blackout-and-replay of the whole show.
+ *
+ * Channel data is read back in chunks because a full universe plus
+ * header does not fit in one RPMSG buffer (RL_BUFFER_PAYLOAD_SIZE).
+ *
+ * Command payload: empty (= offset 0) or [offset:2] [count:2]
+ *   count is clamped to DMX_UNIVERSE_CHUNK_MAX; empty payload requests
+ *   the first chunk.
+ *
+ * Response payload: dmx_universe_payload_t
+ *   The config header repeats in every chunk (it is small and keeps
+ *   each response self-describing).
+ */
+#define DMX_UNIVERSE_CHUNK_MAX  256  /* Channels per readback response */
+
+typedef struct {
+    uint8_t enabled;        /* 1 = transmission running */
+    uint8_t rsvd;           /* Alignment/reserved */
+    uint16_t refresh_hz;    /* Current frame rate (Hz) */
+    uint16_t break_us;      /* Current BREAK duration (µs) */
+    uint16_t mab_us;        /* Current MAB duration (µs) */
+    uint16_t slots;         /* Channels per frame (1-512) */
+    uint16_t offset;        /* First channel in this chunk (0-indexed) */
+    uint16_t count;         /* Channels in this chunk */
+    uint8_t channels[];     /* count channel values */
+} __attribute__((packed)) dmx_universe_payload_t;
+
+/*
+ * CMD_DMX_SUBSCRIBE (AP only)
+ *
+ * Streaming status: instead of polling CMD_DMX_GET_STATUS in a loop
+ * (one subprocess or round trip per sample), a client subscribes once
+ * and the firmware pushes status unsolicited at the requested rate over
+ * the same connection. Pushed packets use the event framing below so a
+ * client can tell them apart from command responses.
+ *
+ * Command payload: [interval_ms:2]
+ *   interval_ms = 0 unsubscribes. Non-zero intervals are clamped to
+ *   DMX_SUB_INTERVAL_MIN_MS. One subscriber at a time: a new subscribe
+ *   replaces the previous one (the tty device is shared, so two pollers
+ *   would interleave on the same fd anyway).
+ *
+ * Event packet (RT-Thread → Linux, unsolicited):
+ *   [magic:1=0xBE] [type:1] [length:2] [payload:N] [checksum:1]
+ *   type is the command whose response payload follows; currently only
+ *   CMD_DMX_GET_STATUS with a dmx_status_payload_t. The subscription
+ *   tracks the universe the subscribe command addressed.
+ */
+#define DMX_SUB_INTERVAL_MIN_MS  10   /* Fastest push rate (100 Hz) */
+
+typedef struct {
+    uint16_t interval_ms;   /* Push period in ms, 0 = unsubscribe */
+} __attribute__((packed)) dmx_subscribe_payload_t;
+
+/* ============================================================================
+ * Shared-Memory Universe Mirror
+ * ============================================================================ */
+
+/*
+ * Zero-copy channel path over shared DDR
+ *
+ * The RPMSG tty path serializes every universe update through
+ * packetization, checksum, vring copy and the tty line discipline - all
+ * to move at most 512 bytes. The mirror skips all of that for bulk
+ * channel data: Linux memcpys into channels[] and bumps the seqlock,
+ * the AP TX thread snapshots a consistent copy at frame-build time.
+ * Control (enable/timing/status) stays on RPMSG.
+ *
+ * Location: last 64KB page of the amp_shmem_reserved region
+ * (0x03b00000, 1MB, no-map - see the dtsi files under custom-configs),
+ * away from anything the vendor AMP code keeps at the region start.
+ * Linux maps it via /dev/mem; the firmware must map it non-cacheable
+ * like the RPMSG rings.
+ *
+ * Seqlock: the writer bumps seq to odd, writes channels, bumps seq to
+ * even. Readers retry while seq is odd or changed across their copy.
+ * Single writer assumed (the client/daemon owns the mirror).
+ */
+#define DMX_SHM_PHYS_ADDR   0x03BF0000UL
+#define DMX_SHM_MAGIC       0x444D5831UL    /* "DMX1" */
+
+typedef struct {
+    uint32_t magic;         /* DMX_SHM_MAGIC once the firmware side is up */
+    uint32_t seq;           /* Seqlock generation (odd = write in progress) */
+    uint32_t publish_count; /* Total publishes (diagnostics) */
+    uint32_t rsvd;          /* Pad header to 16 bytes */
+    uint8_t channels[DMX_MAX_CHANNELS];
+} __attribute__((packed)) dmx_shm_universe_t;
+
 /* ============================================================================
  * Helper Functions (inline for header-only)
  * ============================================================================ */
@@ -18,6 +18,7 @@
 /* Include protocol and DMX driver */
 #include "dmx_protocol.h"
 #include "dmx_driver.h"
+#include "dmx_log.h"
 
 /* ============================================================================
  * Configuration
@@ -40,8 +41,31 @@ extern uint32_t __linux_share_rpmsg_end__[];
 
 static struct rpmsg_lite_instance *g_rpmsg_instance = NULL;
 static struct rpmsg_lite_endpoint *g_rpmsg_ept = NULL;
+static struct rpmsg_lite_endpoint *g_rpmsg_raw_ept = NULL;
 static rpmsg_queue_handle g_rpmsg_queue = NULL;
 
+/*
+ * Status subscription (CMD_DMX_SUBSCRIBE). One subscriber at a time - a
+ * new subscribe replaces the previous one. active is the only field the
+ * push thread tests without holding anything: the handler writes the
+ * parameters first and flips active last, and a stale interval for one
+ * push period is harmless.
+ */
+static struct {
+    volatile bool active;   /* Push thread sends while set */
+    uint16_t interval_ms;   /* Push period (>= DMX_SUB_INTERVAL_MIN_MS) */
+    uint8_t universe;       /* Universe whose status is pushed */
+    uint32_t dst_addr;      /* Subscriber's rpmsg source address */
+} g_sub;
+
+/*
+ * Source address of the command currently being dispatched. Dispatch is
+ * single-threaded (rpmsg_recv_thread), so a plain static is safe; it
+ * exists because execute_command() deliberately hides addressing from
+ * the handlers and only CMD_DMX_SUBSCRIBE needs to know its caller.
+ */
+static uint32_t g_cmd_src_addr;
+
 /* ============================================================================
  * Response Helpers
  * ============================================================================ */
@@ -67,184 +91,723 @@ static void send_response(uint32_t dst_addr, uint8_t status, const uint8_t *payl
                               resp_buf, total_len, RL_BLOCK);
 
     if (ret == RL_SUCCESS) {
-        rt_kprintf("[RPMSG] Sent response: status=0x%02x, len=%d\n", status, total_len);
+        DMX_LOGD("[RPMSG] Sent response: status=0x%02x, len=%d", status, total_len, 0);
+    } else {
+        DMX_LOGE("[RPMSG] Failed to send response (ret=%d)", (uint32_t)ret, 0, 0);
+    }
+}
+
+/*
+ * v2 response: same as send_response() but with the 6-byte v2 header
+ * echoing the command's sequence tag and target universe.
+ */
+static void send_response_v2(uint32_t dst_addr, uint8_t status, uint8_t seq,
+                             uint8_t universe,
+                             const uint8_t *payload, uint16_t payload_len)
+{
+    uint8_t resp_buf[DMX_MAX_PAYLOAD];
+
+    resp_buf[0] = DMX_MAGIC_RESP_V2;
+    resp_buf[1] = status;
+    resp_buf[2] = seq;
+    resp_buf[3] = universe;
+    resp_buf[4] = payload_len & 0xFF;
+    resp_buf[5] = (payload_len >> 8) & 0xFF;
+
+    if (payload_len > 0 && payload) {
+        rt_memcpy(&resp_buf[6], payload, payload_len);
+    }
+
+    uint8_t checksum = dmx_calc_checksum(resp_buf, 6 + payload_len);
+    resp_buf[6 + payload_len] = checksum;
+
+    int total_len = 6 + payload_len + 1;
+    int ret = rpmsg_lite_send(g_rpmsg_instance, g_rpmsg_ept, dst_addr,
+                              resp_buf, total_len, RL_BLOCK);
+
+    if (ret == RL_SUCCESS) {
+        DMX_LOGD("[RPMSG] Sent v2 response: status=0x%02x, seq=%d, len=%d",
+                 status, seq, total_len);
     } else {
-        rt_kprintf("[RPMSG] ERROR: Failed to send response (ret=%d)\n", ret);
+        DMX_LOGE("[RPMSG] Failed to send v2 response (ret=%d)", (uint32_t)ret, 0, 0);
+    }
+}
+
+/*
+ * Unsolicited push: [0xBE][type][len:2][payload][checksum]. Same shape
+ * as a v1 response but with the event magic, so a client reading the
+ * shared fd can tell pushes apart from command responses. Runs on the
+ * push thread, hence the small local buffer instead of the
+ * DMX_MAX_PAYLOAD scratch the response helpers use.
+ */
+static void send_event(uint32_t dst_addr, uint8_t type,
+                       const uint8_t *payload, uint16_t payload_len)
+{
+    uint8_t evt_buf[64];
+
+    if ((uint32_t)payload_len + 5 > sizeof(evt_buf)) {
+        DMX_LOGE("[RPMSG] Event payload too large (%d)", payload_len, 0, 0);
+        return;
+    }
+
+    evt_buf[0] = DMX_MAGIC_EVENT;
+    evt_buf[1] = type;
+    evt_buf[2] = payload_len & 0xFF;
+    evt_buf[3] = (payload_len >> 8) & 0xFF;
+
+    if (payload_len > 0 && payload) {
+        rt_memcpy(&evt_buf[4], payload, payload_len);
+    }
+
+    evt_buf[4 + payload_len] = dmx_calc_checksum(evt_buf, 4 + payload_len);
+
+    int ret = rpmsg_lite_send(g_rpmsg_instance, g_rpmsg_ept, dst_addr,
+                              evt_buf, 4 + payload_len + 1, RL_BLOCK);
+    if (ret != RL_SUCCESS) {
+        DMX_LOGE("[RPMSG] Failed to send event (ret=%d)", (uint32_t)ret, 0, 0);
     }
 }
 
 /* ============================================================================
  * Command Handlers - Phase 3 (Real DMX)
+ *
+ * Handlers return a status byte and fill a response payload; the caller
+ * (parse_command or the batch container) owns the actual send. This keeps
+ * every command usable as a CMD_DMX_BATCH sub-command without a second
+ * response path.
  * ============================================================================ */
 
-static void handle_cmd_enable(uint32_t dst_addr)
+static uint8_t exec_cmd_enable(uint8_t universe)
 {
-    rt_kprintf("[DMX] ENABLE command\n");
-    dmx_enable();
-    send_response(dst_addr, STATUS_OK, NULL, 0);
+    DMX_LOGI("[DMX] ENABLE command (universe %d)", universe, 0, 0);
+    dmx_enable(universe);
+    return STATUS_OK;
 }
 
-static void handle_cmd_disable(uint32_t dst_addr)
+static uint8_t exec_cmd_disable(uint8_t universe)
 {
-    rt_kprintf("[DMX] DISABLE command\n");
-    dmx_disable();
-    send_response(dst_addr, STATUS_OK, NULL, 0);
+    DMX_LOGI("[DMX] DISABLE command (universe %d)", universe, 0, 0);
+    dmx_disable(universe);
+    return STATUS_OK;
 }
 
-static void handle_cmd_set_channels(uint32_t dst_addr, const uint8_t *data, uint16_t len)
+static uint8_t exec_cmd_set_channels(uint8_t universe, const uint8_t *data, uint16_t len)
 {
     if (len < 2) {
-        rt_kprintf("[DMX] ERROR: SET_CHANNELS payload too short\n");
-        send_response(dst_addr, STATUS_INVALID_LENGTH, NULL, 0);
-        return;
+        DMX_LOGE("[DMX] SET_CHANNELS payload too short", 0, 0, 0);
+        return STATUS_INVALID_LENGTH;
     }
 
     uint16_t start_channel = data[0] | (data[1] << 8);
     uint16_t count = len - 2;
 
     if (start_channel + count > DMX_MAX_CHANNELS) {
-        rt_kprintf("[DMX] ERROR: Channel range out of bounds\n");
-        send_response(dst_addr, STATUS_ERROR, NULL, 0);
-        return;
+        DMX_LOGE("[DMX] SET_CHANNELS range out of bounds", 0, 0, 0);
+        return STATUS_ERROR;
     }
 
-    rt_kprintf("[DMX] SET_CHANNELS: start=%d, count=%d\n", start_channel, count);
+    DMX_LOGI("[DMX] SET_CHANNELS: start=%d, count=%d", start_channel, count, 0);
 
     /* Update DMX driver */
-    if (dmx_set_channels(start_channel, &data[2], count) < 0) {
-        rt_kprintf("[DMX] ERROR: dmx_set_channels failed\n");
-        send_response(dst_addr, STATUS_ERROR, NULL, 0);
-        return;
+    if (dmx_set_channels(universe, start_channel, &data[2], count) < 0) {
+        DMX_LOGE("[DMX] dmx_set_channels failed", 0, 0, 0);
+        return STATUS_ERROR;
+    }
+
+    return STATUS_OK;
+}
+
+static uint8_t exec_cmd_set_sparse(uint8_t universe, const uint8_t *data, uint16_t len)
+{
+    if (len == 0 || (len % 3) != 0) {
+        DMX_LOGE("[DMX] SET_SPARSE payload not a multiple of 3", 0, 0, 0);
+        return STATUS_INVALID_LENGTH;
+    }
+
+    uint16_t count = len / 3;
+    DMX_LOGI("[DMX] SET_SPARSE: %d pairs", count, 0, 0);
+
+    if (dmx_set_sparse(universe, data, count) < 0) {
+        DMX_LOGE("[DMX] dmx_set_sparse failed (channel out of range)", 0, 0, 0);
+        return STATUS_ERROR;
+    }
+
+    return STATUS_OK;
+}
+
+static uint8_t exec_cmd_fade(uint8_t universe, const uint8_t *data, uint16_t len)
+{
+    /* Header (start:2 + duration:2 + easing:1) + at least one target */
+    if (len < sizeof(dmx_fade_t) + 1) {
+        DMX_LOGE("[DMX] FADE payload too short", 0, 0, 0);
+        return STATUS_INVALID_LENGTH;
+    }
+
+    const dmx_fade_t *fade = (const dmx_fade_t *)data;
+    uint16_t count = len - sizeof(dmx_fade_t);
+
+    DMX_LOGI("[DMX] FADE: start=%d, count=%d, %dms",
+             fade->channel_start, count, fade->duration_ms);
+
+    if (dmx_fade_start(universe, fade->channel_start, fade->targets, count,
+                       fade->duration_ms, fade->easing) < 0) {
+        DMX_LOGE("[DMX] dmx_fade_start failed", 0, 0, 0);
+        return STATUS_ERROR;
+    }
+
+    return STATUS_OK;
+}
+
+static uint8_t exec_cmd_stage(uint8_t universe, const uint8_t *data, uint16_t len)
+{
+    if (len < 2) {
+        DMX_LOGE("[DMX] STAGE payload too short", 0, 0, 0);
+        return STATUS_INVALID_LENGTH;
+    }
+
+    uint16_t start_channel = data[0] | (data[1] << 8);
+    uint16_t count = len - 2;
+
+    DMX_LOGI("[DMX] STAGE: start=%d, count=%d", start_channel, count, 0);
+
+    if (dmx_stage_channels(universe, start_channel, &data[2], count) < 0) {
+        DMX_LOGE("[DMX] dmx_stage_channels failed", 0, 0, 0);
+        return STATUS_ERROR;
+    }
+
+    return STATUS_OK;
+}
+
+static uint8_t exec_cmd_commit(uint8_t universe)
+{
+    DMX_LOGI("[DMX] COMMIT command (universe %d)", universe, 0, 0);
+
+    if (dmx_commit(universe) < 0) {
+        return STATUS_ERROR;
     }
 
-    send_response(dst_addr, STATUS_OK, NULL, 0);
+    return STATUS_OK;
 }
 
-static void handle_cmd_get_status(uint32_t dst_addr)
+static uint8_t exec_cmd_get_status(uint8_t universe, uint8_t *resp_data, uint16_t *resp_len)
 {
-    rt_kprintf("[DMX] GET_STATUS command\n");
+    DMX_LOGI("[DMX] GET_STATUS command (universe %d)", universe, 0, 0);
 
     dmx_driver_status_t dmx_st;
-    dmx_get_status(&dmx_st);
+    dmx_get_status(universe, &dmx_st);
 
     dmx_status_payload_t status;
     status.enabled = dmx_st.enabled ? 1 : 0;
     status.frame_count = dmx_st.frame_count;
     status.fps = dmx_st.fps;
+    status.effective_hz = dmx_st.effective_hz;
+    status.throttled = dmx_st.throttled ? 1 : 0;
+    status.rsvd = 0;
 
-    send_response(dst_addr, STATUS_OK, (uint8_t *)&status, sizeof(status));
+    rt_memcpy(resp_data, &status, sizeof(status));
+    *resp_len = sizeof(status);
+    return STATUS_OK;
 }
 
-static void handle_cmd_blackout(uint32_t dst_addr)
+static uint8_t exec_cmd_get_stats(uint8_t universe, uint8_t *resp_data, uint16_t *resp_len)
 {
-    rt_kprintf("[DMX] BLACKOUT command\n");
-    dmx_blackout();
-    send_response(dst_addr, STATUS_OK, NULL, 0);
+    dmx_stats_payload_t stats;
+
+    DMX_LOGI("[DMX] GET_STATS command (universe %d)", universe, 0, 0);
+
+    dmx_get_stats(universe, &stats);
+
+    rt_memcpy(resp_data, &stats, sizeof(stats));
+    *resp_len = sizeof(stats);
+    return STATUS_OK;
 }
 
-static void handle_cmd_set_timing(uint32_t dst_addr, uint8_t *payload, uint16_t len)
+static uint8_t exec_cmd_capture(uint8_t universe, const uint8_t *payload,
+                                uint16_t len, uint8_t *resp_data,
+                                uint16_t *resp_len)
 {
-    if (len != sizeof(dmx_timing_t)) {
-        rt_kprintf("[DMX] ERR: Invalid SET_TIMING payload length %d (expected %d)\n",
-                   len, sizeof(dmx_timing_t));
-        send_response(dst_addr, STATUS_INVALID_LENGTH, NULL, 0);
-        return;
+    /* Capture always observes the universe-0 output on the loopback */
+    if (universe != 0) {
+        return STATUS_INVALID_UNIVERSE;
+    }
+    if (len < 1) {
+        return STATUS_INVALID_LENGTH;
     }
 
-    dmx_timing_t *timing = (dmx_timing_t *)payload;
-    rt_kprintf("[DMX] SET_TIMING: %dHz, BREAK=%dµs, MAB=%dµs (0=unchanged)\n",
-               timing->refresh_hz, timing->break_us, timing->mab_us);
+    switch (payload[0]) {
+        case DMX_CAPTURE_OP_START: {
+            if (len < 3) {
+                return STATUS_INVALID_LENGTH;
+            }
+            uint16_t frames = payload[1] | (payload[2] << 8);
+
+            DMX_LOGI("[DMX] CAPTURE start (%d frames)", frames, 0, 0);
+            if (dmx_capture_start(frames) != 0) {
+                DMX_LOGE("[DMX] Capture start rejected (UART busy/absent?)",
+                         0, 0, 0);
+                return STATUS_ERROR;
+            }
+            return STATUS_OK;
+        }
 
-    int ret = dmx_set_timing(timing->refresh_hz, timing->break_us, timing->mab_us);
-    if (ret != 0) {
-        send_response(dst_addr, STATUS_ERROR, NULL, 0);
-    } else {
-        send_response(dst_addr, STATUS_OK, NULL, 0);
+        case DMX_CAPTURE_OP_REPORT: {
+            dmx_capture_payload_t report;
+
+            DMX_LOGD("[DMX] CAPTURE report", 0, 0, 0);
+            if (dmx_capture_report(&report) != 0) {
+                return STATUS_ERROR;
+            }
+            rt_memcpy(resp_data, &report, sizeof(report));
+            *resp_len = sizeof(report);
+            return STATUS_OK;
+        }
+
+        default:
+            DMX_LOGE("[DMX] Unknown capture op 0x%02x", payload[0], 0, 0);
+            return STATUS_ERROR;
+    }
+}
+
+static uint8_t exec_cmd_get_universe(uint8_t universe, const uint8_t *payload,
+                                     uint16_t len, uint8_t *resp_data,
+                                     uint16_t *resp_len)
+{
+    uint16_t offset = 0;
+    uint16_t count = DMX_UNIVERSE_CHUNK_MAX;
+
+    /* Empty payload = first chunk; [offset:2][count:2] for the rest */
+    if (len == 4) {
+        offset = payload[0] | (payload[1] << 8);
+        count = payload[2] | (payload[3] << 8);
+    } else if (len != 0) {
+        DMX_LOGE("[DMX] GET_UNIVERSE payload must be 0 or 4 bytes", 0, 0, 0);
+        return STATUS_INVALID_LENGTH;
     }
+
+    DMX_LOGI("[DMX] GET_UNIVERSE: offset=%d count=%d (universe %d)",
+             offset, count, universe);
+
+    dmx_universe_payload_t *out = (dmx_universe_payload_t *)resp_data;
+    if (dmx_get_universe(universe, offset, count, out) < 0) {
+        DMX_LOGE("[DMX] dmx_get_universe failed (bad offset?)", 0, 0, 0);
+        return STATUS_ERROR;
+    }
+
+    *resp_len = sizeof(dmx_universe_payload_t) + out->count;
+    return STATUS_OK;
 }
 
-static void handle_cmd_get_timing(uint32_t dst_addr)
+static uint8_t exec_cmd_scene_store(uint8_t universe, const uint8_t *payload,
+                                    uint16_t len)
+{
+    if (len != 1) {
+        DMX_LOGE("[DMX] SCENE_STORE payload must be 1 byte", 0, 0, 0);
+        return STATUS_INVALID_LENGTH;
+    }
+
+    DMX_LOGI("[DMX] SCENE_STORE: slot %d (universe %d)",
+             payload[0], universe, 0);
+
+    if (dmx_scene_store(universe, payload[0]) < 0) {
+        DMX_LOGE("[DMX] dmx_scene_store failed (bad slot?)", 0, 0, 0);
+        return STATUS_ERROR;
+    }
+
+    return STATUS_OK;
+}
+
+static uint8_t exec_cmd_scene_recall(uint8_t universe, const uint8_t *payload,
+                                     uint16_t len)
+{
+    uint16_t duration_ms = 0;
+    uint8_t easing = DMX_FADE_LINEAR;
+
+    /* [scene:1] = instant, [scene:1][duration_ms:2][easing:1] = crossfade */
+    if (len == 4) {
+        duration_ms = payload[1] | (payload[2] << 8);
+        easing = payload[3];
+    } else if (len != 1) {
+        DMX_LOGE("[DMX] SCENE_RECALL payload must be 1 or 4 bytes", 0, 0, 0);
+        return STATUS_INVALID_LENGTH;
+    }
+
+    DMX_LOGI("[DMX] SCENE_RECALL: slot %d, %dms (universe %d)",
+             payload[0], duration_ms, universe);
+
+    if (dmx_scene_recall(universe, payload[0], duration_ms, easing) < 0) {
+        DMX_LOGE("[DMX] dmx_scene_recall failed (empty slot?)", 0, 0, 0);
+        return STATUS_ERROR;
+    }
+
+    return STATUS_OK;
+}
+
+static uint8_t exec_cmd_subscribe(uint8_t universe, const uint8_t *payload,
+                                  uint16_t len)
+{
+    if (len != sizeof(dmx_subscribe_payload_t)) {
+        DMX_LOGE("[DMX] Invalid SUBSCRIBE payload length %d (expected %d)",
+                 len, sizeof(dmx_subscribe_payload_t), 0);
+        return STATUS_INVALID_LENGTH;
+    }
+
+    uint16_t interval_ms = payload[0] | (payload[1] << 8);
+
+    if (interval_ms == 0) {
+        g_sub.active = false;
+        DMX_LOGI("[DMX] SUBSCRIBE: unsubscribed", 0, 0, 0);
+        return STATUS_OK;
+    }
+
+    if (interval_ms < DMX_SUB_INTERVAL_MIN_MS) {
+        interval_ms = DMX_SUB_INTERVAL_MIN_MS;
+    }
+
+    /* Parameters before active - see g_sub comment */
+    g_sub.active = false;
+    g_sub.interval_ms = interval_ms;
+    g_sub.universe = universe;
+    g_sub.dst_addr = g_cmd_src_addr;
+    g_sub.active = true;
+
+    DMX_LOGI("[DMX] SUBSCRIBE: universe %d every %dms (dst=0x%x)",
+             universe, interval_ms, g_cmd_src_addr);
+    return STATUS_OK;
+}
+
+static uint8_t exec_cmd_blackout(uint8_t universe)
+{
+    DMX_LOGI("[DMX] BLACKOUT command (universe %d)", universe, 0, 0);
+    dmx_blackout(universe);
+    return STATUS_OK;
+}
+
+static uint8_t exec_cmd_set_timing(uint8_t universe, const uint8_t *payload, uint16_t len)
+{
+    /* Legacy 6-byte payload (no slots field) still accepted; the
+     * extended form appends adaptive-refresh control */
+    if (len != sizeof(dmx_timing_t) && len != DMX_TIMING_LEN_V1 &&
+        len != sizeof(dmx_timing_adaptive_t)) {
+        DMX_LOGE("[DMX] Invalid SET_TIMING payload length %d (expected %d or %d)",
+                 len, DMX_TIMING_LEN_V1, sizeof(dmx_timing_t));
+        return STATUS_INVALID_LENGTH;
+    }
+
+    const dmx_timing_t *timing = (const dmx_timing_t *)payload;
+    uint16_t slots = (len >= sizeof(dmx_timing_t)) ? timing->slots : 0;
+
+    DMX_LOGI("[DMX] SET_TIMING: %dHz, BREAK=%dµs, MAB=%dµs (0=unchanged)",
+             timing->refresh_hz, timing->break_us, timing->mab_us);
+    if (slots != 0) {
+        DMX_LOGI("[DMX] SET_TIMING: %d slots", slots, 0, 0);
+    }
+
+    if (dmx_set_timing(universe, timing->refresh_hz, timing->break_us,
+                       timing->mab_us, slots) != 0) {
+        return STATUS_ERROR;
+    }
+
+    if (len == sizeof(dmx_timing_adaptive_t)) {
+        const dmx_timing_adaptive_t *adapt =
+            (const dmx_timing_adaptive_t *)payload;
+
+        DMX_LOGI("[DMX] SET_TIMING: keepalive=%dHz after %d idle frames",
+                 adapt->keepalive_hz, adapt->idle_frames, 0);
+        if (dmx_set_adaptive(universe, adapt->keepalive_hz,
+                             adapt->idle_frames) != 0) {
+            return STATUS_ERROR;
+        }
+    }
+    return STATUS_OK;
+}
+
+static uint8_t exec_cmd_get_timing(uint8_t universe, uint8_t *resp_data, uint16_t *resp_len)
 {
     dmx_timing_payload_t timing;
 
-    dmx_get_timing(&timing.refresh_hz, &timing.break_us, &timing.mab_us);
+    dmx_get_timing(universe, &timing.refresh_hz, &timing.break_us,
+                   &timing.mab_us, &timing.slots);
+
+    DMX_LOGI("[DMX] GET_TIMING: %dHz, BREAK=%dµs, MAB=%dµs",
+             timing.refresh_hz, timing.break_us, timing.mab_us);
+
+    rt_memcpy(resp_data, &timing, sizeof(timing));
+    *resp_len = sizeof(timing);
+    return STATUS_OK;
+}
+
+/*
+ * Dispatch one (sub-)command. resp_data must have room for the largest
+ * single response payload; *resp_len is set to 0 for payload-less replies.
+ *
+ * universe comes from the v2 header byte; v1 framing (and batch
+ * sub-commands) always address universe 0.
+ */
+static uint8_t execute_command(uint8_t cmd, uint8_t universe,
+                               const uint8_t *payload, uint16_t payload_len,
+                               uint8_t *resp_data, uint16_t *resp_len)
+{
+    *resp_len = 0;
+
+    if (universe >= DMX_NUM_UNIVERSES) {
+        DMX_LOGE("[RPMSG] Invalid universe %d (max %d)",
+                 universe, DMX_NUM_UNIVERSES - 1, 0);
+        return STATUS_INVALID_UNIVERSE;
+    }
+
+    switch (cmd) {
+        case CMD_DMX_ENABLE:
+            return exec_cmd_enable(universe);
+
+        case CMD_DMX_DISABLE:
+            return exec_cmd_disable(universe);
+
+        case CMD_DMX_SET_CHANNELS:
+            return exec_cmd_set_channels(universe, payload, payload_len);
+
+        case CMD_DMX_SET_SPARSE:
+            return exec_cmd_set_sparse(universe, payload, payload_len);
+
+        case CMD_DMX_FADE:
+            return exec_cmd_fade(universe, payload, payload_len);
+
+        case CMD_DMX_STAGE:
+            return exec_cmd_stage(universe, payload, payload_len);
+
+        case CMD_DMX_COMMIT:
+            return exec_cmd_commit(universe);
+
+        case CMD_DMX_GET_STATUS:
+            return exec_cmd_get_status(universe, resp_data, resp_len);
+
+        case CMD_DMX_GET_STATS:
+            return exec_cmd_get_stats(universe, resp_data, resp_len);
+
+        case CMD_DMX_CAPTURE:
+            return exec_cmd_capture(universe, payload, payload_len,
+                                    resp_data, resp_len);
+
+        case CMD_DMX_GET_UNIVERSE:
+            return exec_cmd_get_universe(universe, payload, payload_len,
+                                         resp_data, resp_len);
+
+        case CMD_DMX_SCENE_STORE:
+            return exec_cmd_scene_store(universe, payload, payload_len);
 
-    rt_kprintf("[DMX] GET_TIMING: %dHz, BREAK=%dµs, MAB=%dµs\n",
-               timing.refresh_hz, timing.break_us, timing.mab_us);
+        case CMD_DMX_SCENE_RECALL:
+            return exec_cmd_scene_recall(universe, payload, payload_len);
 
-    send_response(dst_addr, STATUS_OK, (uint8_t *)&timing, sizeof(timing));
+        case CMD_DMX_SUBSCRIBE:
+            return exec_cmd_subscribe(universe, payload, payload_len);
+
+        case CMD_DMX_BLACKOUT:
+            return exec_cmd_blackout(universe);
+
+        case CMD_DMX_SET_TIMING:
+            return exec_cmd_set_timing(universe, payload, payload_len);
+
+        case CMD_DMX_GET_TIMING:
+            return exec_cmd_get_timing(universe, resp_data, resp_len);
+
+        default:
+            DMX_LOGE("[RPMSG] Unknown command 0x%02x", cmd, 0, 0);
+            return STATUS_INVALID_CMD;
+    }
+}
+
+/* ============================================================================
+ * Batch Container
+ * ============================================================================ */
+
+/*
+ * CMD_DMX_BATCH: execute [cmd:1][len:2][data] entries in sequence and
+ * aggregate [status:1][len:2][data] results into one response.
+ *
+ * Buffers are static: dispatch is single-threaded (rpmsg_recv_thread) and
+ * the 2KB thread stack cannot hold two DMX_MAX_PAYLOAD scratch areas.
+ */
+static void handle_cmd_batch(uint32_t dst_addr, const uint8_t *data, uint16_t len)
+{
+    static uint8_t results[DMX_MAX_PAYLOAD];
+    static uint8_t sub_resp[DMX_MAX_PAYLOAD];
+    uint16_t results_len = 0;
+    uint16_t off = 0;
+    int count = 0;
+
+    while (off < len) {
+        if ((uint16_t)(len - off) < 3) {
+            DMX_LOGE("[RPMSG] Truncated batch entry at offset %d", off, 0, 0);
+            send_response(dst_addr, STATUS_INVALID_LENGTH, NULL, 0);
+            return;
+        }
+
+        uint8_t sub_cmd = data[off];
+        uint16_t sub_len = data[off + 1] | (data[off + 2] << 8);
+        off += 3;
+
+        /* No nesting, no overruns */
+        if (sub_cmd == CMD_DMX_BATCH || sub_len > (uint16_t)(len - off)) {
+            DMX_LOGE("[RPMSG] Malformed batch entry (cmd=0x%02x, len=%d)",
+                     sub_cmd, sub_len, 0);
+            send_response(dst_addr, STATUS_INVALID_LENGTH, NULL, 0);
+            return;
+        }
+
+        uint16_t sub_resp_len = 0;
+        /* Batch keeps v1 framing, so sub-commands address universe 0 */
+        uint8_t sub_status = execute_command(sub_cmd, 0, (sub_len > 0) ? &data[off] : NULL,
+                                             sub_len, sub_resp, &sub_resp_len);
+        off += sub_len;
+
+        /* Result must fit the aggregate response (header + payload + checksum) */
+        if ((uint32_t)results_len + 3 + sub_resp_len > DMX_MAX_PAYLOAD - 5) {
+            DMX_LOGE("[RPMSG] Batch response overflow", 0, 0, 0);
+            send_response(dst_addr, STATUS_INVALID_LENGTH, NULL, 0);
+            return;
+        }
+
+        results[results_len]     = sub_status;
+        results[results_len + 1] = sub_resp_len & 0xFF;
+        results[results_len + 2] = (sub_resp_len >> 8) & 0xFF;
+        if (sub_resp_len > 0) {
+            rt_memcpy(&results[results_len + 3], sub_resp, sub_resp_len);
+        }
+        results_len += 3 + sub_resp_len;
+        count++;
+    }
+
+    DMX_LOGI("[RPMSG] BATCH: %d sub-commands executed", count, 0, 0);
+    send_response(dst_addr, STATUS_OK, results, results_len);
 }
 
 /* ============================================================================
  * Command Parser
  * ============================================================================ */
 
+/*
+ * v2 framing: [magic:1][cmd:1][seq:1][universe:1][len:2][data][checksum:1]
+ *
+ * The sequence tag is echoed in the response so the client can pipeline
+ * several commands and match responses by tag. Dispatch itself stays
+ * serialized (single rpmsg_rx thread), which also keeps responses in
+ * command order. The universe byte selects the DMX output (v1 framing
+ * always addresses universe 0).
+ */
+static void parse_command_v2(uint8_t *rx_buf, uint32_t rx_len, uint32_t src_addr)
+{
+    static uint8_t resp_data[DMX_MAX_PAYLOAD];
+
+    uint8_t seq = (rx_len >= 3) ? rx_buf[2] : 0;
+    uint8_t universe = (rx_len >= 4) ? rx_buf[3] : 0;
+
+    /* Minimum packet: header(6) + checksum(1) = 7 bytes */
+    if (rx_len < 7) {
+        DMX_LOGE("[RPMSG] v2 packet too short (%d bytes)", rx_len, 0, 0);
+        send_response_v2(src_addr, STATUS_INVALID_LENGTH, seq, universe, NULL, 0);
+        return;
+    }
+
+    if (!dmx_verify_checksum(rx_buf, rx_len)) {
+        DMX_LOGE("[RPMSG] Invalid v2 checksum", 0, 0, 0);
+        send_response_v2(src_addr, STATUS_INVALID_CHECKSUM, seq, universe, NULL, 0);
+        return;
+    }
+
+    uint8_t cmd = rx_buf[1] & DMX_CMD_TYPE_MASK;
+    bool no_ack = (rx_buf[1] & DMX_CMD_FLAG_NO_ACK) != 0;
+    uint16_t payload_len = rx_buf[4] | (rx_buf[5] << 8);
+    uint8_t *payload = (payload_len > 0) ? &rx_buf[6] : NULL;
+
+    DMX_LOGI("[RPMSG] CMD v2: 0x%02x, universe=%d, payload_len=%d",
+             cmd, universe, payload_len);
+
+    /* CMD_DMX_BATCH keeps v1 framing - it aggregates its own response */
+    if (cmd == CMD_DMX_BATCH) {
+        send_response_v2(src_addr, STATUS_INVALID_CMD, seq, universe, NULL, 0);
+        return;
+    }
+
+    uint16_t resp_len = 0;
+    uint8_t status = execute_command(cmd, universe, payload, payload_len,
+                                     resp_data, &resp_len);
+
+    if (no_ack) {
+        if (status != STATUS_OK) {
+            dmx_count_error(universe < DMX_NUM_UNIVERSES ? universe : 0);
+        }
+        return;
+    }
+
+    send_response_v2(src_addr, status, seq, universe,
+                     (resp_len > 0) ? resp_data : NULL, resp_len);
+}
+
 static void parse_command(uint8_t *rx_buf, uint32_t rx_len, uint32_t src_addr)
 {
+    /* Response scratch - static for the same stack reason as the batch */
+    static uint8_t resp_data[DMX_MAX_PAYLOAD];
+
+    /* For handlers that need their caller's address (CMD_DMX_SUBSCRIBE) */
+    g_cmd_src_addr = src_addr;
+
     /* Minimum packet: magic(1) + cmd(1) + len(2) + checksum(1) = 5 bytes */
     if (rx_len < 5) {
-        rt_kprintf("[RPMSG] ERROR: Packet too short (%d bytes)\n", rx_len);
+        DMX_LOGE("[RPMSG] Packet too short (%d bytes)", rx_len, 0, 0);
         send_response(src_addr, STATUS_INVALID_LENGTH, NULL, 0);
         return;
     }
 
+    /* v2 framing carries a sequence tag - separate parse path */
+    if (rx_buf[0] == DMX_MAGIC_CMD_V2) {
+        parse_command_v2(rx_buf, rx_len, src_addr);
+        return;
+    }
+
     /* Verify magic byte */
     if (rx_buf[0] != DMX_MAGIC_CMD) {
-        rt_kprintf("[RPMSG] ERROR: Invalid magic 0x%02x (expected 0x%02x)\n",
-                   rx_buf[0], DMX_MAGIC_CMD);
+        DMX_LOGE("[RPMSG] Invalid magic 0x%02x (expected 0x%02x)",
+                 rx_buf[0], DMX_MAGIC_CMD, 0);
         send_response(src_addr, STATUS_INVALID_MAGIC, NULL, 0);
         return;
     }
 
     /* Verify checksum */
     if (!dmx_verify_checksum(rx_buf, rx_len)) {
-        rt_kprintf("[RPMSG] ERROR: Invalid checksum\n");
+        DMX_LOGE("[RPMSG] Invalid checksum", 0, 0, 0);
         send_response(src_addr, STATUS_INVALID_CHECKSUM, NULL, 0);
         return;
     }
 
-    /* Extract command and payload */
-    uint8_t cmd = rx_buf[1];
+    /* Extract command, flags and payload */
+    uint8_t cmd = rx_buf[1] & DMX_CMD_TYPE_MASK;
+    bool no_ack = (rx_buf[1] & DMX_CMD_FLAG_NO_ACK) != 0;
     uint16_t payload_len = rx_buf[2] | (rx_buf[3] << 8);
     uint8_t *payload = (payload_len > 0) ? &rx_buf[4] : NULL;
 
-    rt_kprintf("[RPMSG] CMD: 0x%02x, payload_len=%d\n", cmd, payload_len);
-
-    /* Dispatch command */
-    switch (cmd) {
-        case CMD_DMX_ENABLE:
-            handle_cmd_enable(src_addr);
-            break;
-
-        case CMD_DMX_DISABLE:
-            handle_cmd_disable(src_addr);
-            break;
+    DMX_LOGI("[RPMSG] CMD: 0x%02x, payload_len=%d, no_ack=%d", cmd, payload_len,
+             no_ack ? 1 : 0);
 
-        case CMD_DMX_SET_CHANNELS:
-            handle_cmd_set_channels(src_addr, payload, payload_len);
-            break;
-
-        case CMD_DMX_GET_STATUS:
-            handle_cmd_get_status(src_addr);
-            break;
-
-        case CMD_DMX_BLACKOUT:
-            handle_cmd_blackout(src_addr);
-            break;
-
-        case CMD_DMX_SET_TIMING:
-            handle_cmd_set_timing(src_addr, payload, payload_len);
-            break;
+    /* Batch container aggregates its own response (NO_ACK not supported) */
+    if (cmd == CMD_DMX_BATCH) {
+        handle_cmd_batch(src_addr, payload, payload_len);
+        return;
+    }
 
-        case CMD_DMX_GET_TIMING:
-            handle_cmd_get_timing(src_addr);
-            break;
+    uint16_t resp_len = 0;
+    uint8_t status = execute_command(cmd, 0, payload, payload_len, resp_data, &resp_len);
 
-        default:
-            rt_kprintf("[RPMSG] ERROR: Unknown command 0x%02x\n", cmd);
-            send_response(src_addr, STATUS_INVALID_CMD, NULL, 0);
-            break;
+    /*
+     * Fire-and-forget: skip the response entirely. Failures still count
+     * via the driver error counter so they surface in status/stats.
+     */
+    if (no_ack) {
+        if (status != STATUS_OK) {
+            dmx_count_error(0);
+        }
+        return;
     }
+
+    send_response(src_addr, status, (resp_len > 0) ? resp_data : NULL, resp_len);
 }
 
 /* ============================================================================
@@ -260,24 +823,101 @@ static void rpmsg_recv_thread(void *parameter)
 
     rt_kprintf("[RPMSG] Reception thread started\n");
 
-    rx_buf = (char *)rt_malloc(RL_BUFFER_PAYLOAD_SIZE);
-    if (!rx_buf) {
-        rt_kprintf("[RPMSG] ERROR: Failed to allocate RX buffer\n");
-        return;
-    }
-
+    /*
+     * Zero-copy receive: parse straight out of the vring buffer instead
+     * of memcpy'ing every packet into a heap buffer first. At 44Hz
+     * streaming that saves a per-packet copy of up to
+     * RL_BUFFER_PAYLOAD_SIZE bytes on CPU2. The buffer stays owned by us
+     * until rpmsg_queue_nocopy_free() - handlers copy what they keep
+     * (channel data goes through dmx_set_channels() etc.), so releasing
+     * right after dispatch is safe.
+     */
     while (1) {
-        ret = rpmsg_queue_recv(g_rpmsg_instance, g_rpmsg_queue,
-                               &src_addr, rx_buf, RL_BUFFER_PAYLOAD_SIZE,
-                               &rx_len, RL_BLOCK);
+        ret = rpmsg_queue_recv_nocopy(g_rpmsg_instance, g_rpmsg_queue,
+                                      &src_addr, &rx_buf, &rx_len, RL_BLOCK);
 
         if (ret == RL_SUCCESS) {
-            rt_kprintf("[RPMSG] RX %d bytes from 0x%x\n", rx_len, src_addr);
+            DMX_LOGD("[RPMSG] RX %d bytes from 0x%x", rx_len, src_addr, 0);
             parse_command((uint8_t *)rx_buf, rx_len, src_addr);
+            rpmsg_queue_nocopy_free(g_rpmsg_instance, rx_buf);
         }
     }
+}
 
-    rt_free(rx_buf);
+/* ============================================================================
+ * Status Push Thread (CMD_DMX_SUBSCRIBE)
+ * ============================================================================ */
+
+/*
+ * Pushes one status event per interval while a subscription is active.
+ * Sleeping before the send means the subscribe ack always reaches the
+ * client before its first event, so the synchronous response reader
+ * never races a push.
+ */
+static void rpmsg_status_push_thread(void *parameter)
+{
+    while (1) {
+        if (!g_sub.active) {
+            rt_thread_mdelay(100);
+            continue;
+        }
+
+        rt_thread_mdelay(g_sub.interval_ms);
+        if (!g_sub.active) {
+            continue;   /* Unsubscribed while sleeping */
+        }
+
+        dmx_driver_status_t dmx_st;
+        dmx_get_status(g_sub.universe, &dmx_st);
+
+        dmx_status_payload_t status;
+        status.enabled = dmx_st.enabled ? 1 : 0;
+        status.frame_count = dmx_st.frame_count;
+        status.fps = dmx_st.fps;
+        status.effective_hz = dmx_st.effective_hz;
+        status.throttled = dmx_st.throttled ? 1 : 0;
+        status.rsvd = 0;
+
+        send_event(g_sub.dst_addr, CMD_DMX_GET_STATUS,
+                   (const uint8_t *)&status, sizeof(status));
+    }
+}
+
+/* ============================================================================
+ * Link Monitor (warm-restart continuity)
+ * ============================================================================ */
+
+/*
+ * DMX output is driven entirely by dmx_tx_thread_entry() from CPU2-local
+ * state, so a Linux reboot must not touch the driver at all. This thread
+ * only watches the virtio link: when the restarted master re-initializes
+ * the vrings, the link status flips and we re-announce the channel so
+ * the new kernel can rebind /dev/ttyRPMSG0. The reconnected client then
+ * resynchronizes with CMD_DMX_GET_UNIVERSE instead of blacking out and
+ * replaying the show.
+ */
+static void rpmsg_link_monitor_thread(void *parameter)
+{
+    int was_up = 1;
+
+    while (1) {
+        int up = rpmsg_lite_is_link_up(g_rpmsg_instance) ? 1 : 0;
+
+        if (!up && was_up) {
+            rt_kprintf("[RPMSG] Link DOWN (Linux restart?) - DMX output continues\n");
+            /* The subscriber went away with the link - stop pushing into
+             * dead vrings; a restarted client subscribes again */
+            g_sub.active = false;
+        } else if (up && !was_up) {
+            rt_kprintf("[RPMSG] Link restored - re-announcing '%s'\n",
+                       RPMSG_CHANNEL_NAME);
+            rpmsg_ns_announce(g_rpmsg_instance, g_rpmsg_ept,
+                              RPMSG_CHANNEL_NAME, RL_NS_CREATE);
+        }
+        was_up = up;
+
+        rt_thread_mdelay(500);
+    }
 }
 
 /* ============================================================================
@@ -314,6 +954,12 @@ static int rpmsg_dmx_init(void)
 
     rt_kprintf("[RPMSG] Shared memory: 0x%x - 0x%x\n", RPMSG_MEM_BASE, RPMSG_MEM_END);
 
+    /* Deferred log ring - hot-path diagnostics go through it instead of
+     * stalling on the console UART */
+    if (dmx_log_init() != RT_EOK) {
+        rt_kprintf("[ERROR] Log drain thread init failed\n");
+    }
+
     /* Initialize DMX driver FIRST */
     rt_kprintf("\n");
     if (dmx_init() != RT_EOK) {
@@ -342,9 +988,22 @@ static int rpmsg_dmx_init(void)
         return -RT_ERROR;
     }
 
-    /* Wait for link up */
+    /*
+     * Wait for link up. The DMX driver is already running at this point
+     * (dmx_init above), so a slow or absent Linux never delays the
+     * output - poll with a timeout and log progress instead of blocking
+     * silently forever.
+     */
     rt_kprintf("[RPMSG] Waiting for link up...\n");
-    rpmsg_lite_wait_for_link_up(g_rpmsg_instance, RL_BLOCK);
+    for (int waited_s = 0;; waited_s++) {
+        if (rpmsg_lite_wait_for_link_up(g_rpmsg_instance, 1000) == RL_SUCCESS) {
+            break;
+        }
+        if (waited_s % 10 == 9) {
+            rt_kprintf("[RPMSG] Still waiting for link (%ds) - DMX unaffected\n",
+                       waited_s + 1);
+        }
+    }
     rt_kprintf("[RPMSG] Link UP!\n");
 
     /* Bind name service */
@@ -367,6 +1026,22 @@ static int rpmsg_dmx_init(void)
 
     rt_kprintf("[RPMSG] Endpoint created (addr=0x%x)\n", RPMSG_EPT_ADDR);
 
+    /*
+     * Second endpoint for the raw rpmsg_char transport. It feeds the
+     * same receive queue - the parser does not care which endpoint a
+     * packet arrived on, and responses are routed by destination
+     * address, so replying from the primary endpoint reaches raw
+     * clients too. Best-effort: losing it costs the raw path only.
+     */
+    g_rpmsg_raw_ept = rpmsg_lite_create_ept(g_rpmsg_instance, DMX_RAW_EPT_ADDR,
+                                            rpmsg_queue_rx_cb, g_rpmsg_queue);
+    if (g_rpmsg_raw_ept) {
+        rt_kprintf("[RPMSG] Raw endpoint created (addr=0x%x)\n",
+                   DMX_RAW_EPT_ADDR);
+    } else {
+        rt_kprintf("[RPMSG] WARNING: raw endpoint creation failed\n");
+    }
+
     /* Announce channel */
     rt_kprintf("[RPMSG] Announcing channel '%s'...\n", RPMSG_CHANNEL_NAME);
     rpmsg_ns_announce(g_rpmsg_instance, g_rpmsg_ept, RPMSG_CHANNEL_NAME, RL_NS_CREATE);
@@ -382,6 +1057,30 @@ static int rpmsg_dmx_init(void)
         return -RT_ERROR;
     }
 
+    /* Link monitor - best-effort (losing it costs auto re-announce,
+     * not DMX output) */
+    rt_thread_t mon_tid = rt_thread_create("rpmsg_mon", rpmsg_link_monitor_thread,
+                                           RT_NULL, 1024,
+                                           RT_THREAD_PRIORITY_MAX - 3, 10);
+    if (mon_tid != RT_NULL) {
+        rt_thread_startup(mon_tid);
+        rt_kprintf("[RPMSG] Link monitor thread created\n");
+    } else {
+        rt_kprintf("[RPMSG] WARNING: Failed to create link monitor\n");
+    }
+
+    /* Status push - best-effort (losing it costs CMD_DMX_SUBSCRIBE,
+     * polling via CMD_DMX_GET_STATUS still works) */
+    rt_thread_t push_tid = rt_thread_create("rpmsg_push", rpmsg_status_push_thread,
+                                            RT_NULL, 1024,
+                                            RT_THREAD_PRIORITY_MAX - 4, 10);
+    if (push_tid != RT_NULL) {
+        rt_thread_startup(push_tid);
+        rt_kprintf("[RPMSG] Status push thread created\n");
+    } else {
+        rt_kprintf("[RPMSG] WARNING: Failed to create status push thread\n");
+    }
+
     rt_kprintf("\n");
     rt_kprintf("========================================\n");
     rt_kprintf("  DMX512 Driver Ready!\n");
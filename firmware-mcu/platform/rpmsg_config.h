@@ -19,6 +19,13 @@
  * Buffer Configuration
  * ============================================================================ */
 
+/*
+ * Deliberately NOT governed by the memory profiles in
+ * src/dmx_mem_profile.h: the vrings live in shared DDR
+ * (RPMSG_MEM_BASE), so shrinking them frees no MCU SRAM, and this
+ * geometry must mirror the Linux-side virtio rpmsg layout - changing
+ * it unilaterally breaks the link.
+ */
 #define RL_BUFFER_PAYLOAD_SIZE (496U)
 #define RL_BUFFER_COUNT (64U)
 /* endpoint size is formed by payload and struct rpmsg_std_hdr */
@@ -5,7 +5,10 @@
  * SPDX-License-Identifier: BSD-3-Clause
  */
 
+#include <string.h>
+
 #include "dmx_driver.h"
+#include "dmx_mem_profile.h"
 #include "hal_base.h"
 
 /* ============================================================================
@@ -14,15 +17,49 @@
 
 #define UART_LCR_BREAK   (1 << 6)   /* Break control bit */
 #define UART_USR_TFE     (1 << 2)   /* TX FIFO empty */
+#define UART_IER_ETBEI   (1 << 1)   /* TX Holding Register Empty interrupt */
+#define UART_IIR_ID_MASK 0x0F       /* Interrupt ID field */
+#define UART_IIR_ID_BUSY 0x07       /* Busy detect (LCR written while busy) */
 /* Note: UART_USR_BUSY is already defined in hal_uart.h */
 
+/* ============================================================================
+ * Frame Sequencing Timer
+ * ============================================================================ */
+
+/*
+ * BREAK and MAB are sequenced by a hardware timer interrupt instead of
+ * HAL_DelayUs() with IRQs off - the old way parked the core for up to
+ * ~1ms per frame and stalled RPMSG reception behind frame generation.
+ * TIMER5 is the free-running system counter; TIMER4 is otherwise unused
+ * on this core and must stay unclaimed by the Linux DT (same deal as
+ * UART2 itself).
+ */
+#define DMX_TIMER        TIMER4
+#define DMX_TIMER_IRQ    TIMER4_IRQn
+#define DMX_TIMER_MHZ    24         /* Timers run off the 24MHz OSC */
+
 /* ============================================================================
  * Private State
  * ============================================================================ */
 
 static struct UART_REG *pUart = UART2;
 
-static uint8_t g_dmx_frame[DMX_FRAME_SIZE];
+/*
+ * DMX frame buffer(s). With DMX_CFG_FRAME_DOUBLE_BUFFER (COMPACT
+ * memory profile) writers fill the back buffer while the TX pipeline
+ * reads the front; the flip happens in dmx_poll() while the pipeline
+ * is provably idle, so a channel write can never tear a frame on the
+ * wire. The STOCK profile keeps the historical single buffer (writes
+ * land mid-frame - visible as one-frame tearing under heavy updates).
+ */
+#if DMX_CFG_FRAME_DOUBLE_BUFFER
+static uint8_t g_frames[2][DMX_FRAME_SIZE];
+static volatile uint8_t g_front = 0;    /* Buffer the TX pipeline reads */
+static uint8_t g_frame_dirty = 0;       /* Back buffer has unpublished writes */
+#else
+static uint8_t g_frames[1][DMX_FRAME_SIZE];
+#endif
+
 static volatile uint32_t g_frame_count = 0;
 static volatile uint8_t g_enabled = 0;  /* Start disabled, enable via CMD_DMX_ENABLE */
 
@@ -30,60 +67,217 @@ static uint16_t g_refresh_hz = DMX_DEFAULT_REFRESH_HZ;
 static uint16_t g_break_us = DMX_DEFAULT_BREAK_US;
 static uint16_t g_mab_us = DMX_DEFAULT_MAB_US;
 
-/* Non-blocking TX state machine */
+/* Event-driven TX pipeline. dmx_poll() only kicks a frame off at its
+ * deadline; the timer ISR sequences BREAK -> MAB and the UART THRE ISR
+ * clocks out the data - the main loop never waits on the wire. */
 typedef enum {
     DMX_STATE_IDLE,
-    DMX_STATE_TX_DATA
+    DMX_STATE_BREAK,     /* LCR break held, timer armed for break_us */
+    DMX_STATE_MAB,       /* Break released, timer armed for mab_us */
+    DMX_STATE_TX_DATA    /* THRE interrupts feeding the FIFO */
 } dmx_tx_state_t;
 
-static dmx_tx_state_t g_dmx_state = DMX_STATE_IDLE;
-static uint16_t g_tx_idx = 0;
+static volatile dmx_tx_state_t g_dmx_state = DMX_STATE_IDLE;
+static volatile uint16_t g_tx_idx = 0;
 static uint64_t g_last_frame_time = 0;
+static uint32_t g_lcr_shadow = 0;   /* LCR value without the break bit */
+
+/* Staged channel data - landed by dmx_stage_channels(), folded into
+ * the frame by dmx_poll() at the next frame boundary after
+ * dmx_commit() (never mid-frame, so a cue can't tear) */
+static uint8_t g_stage_buf[DMX_UNIVERSE_SIZE];
+static uint32_t g_stage_map[DMX_UNIVERSE_SIZE / 32];
+static uint16_t g_stage_lo = 0;
+static uint16_t g_stage_hi = 0;
+static uint8_t g_stage_pending = 0;
+static volatile uint8_t g_commit_pending = 0;
 
 /* ============================================================================
  * Private Functions
  * ============================================================================ */
 
 /**
- * Wait for UART TX to be completely idle
+ * Frame buffer the writers (main-loop command handlers) target
  */
-static void uart_wait_idle(void)
+static inline uint8_t *frame_wr(void)
 {
-    int timeout = 100000;
-    while (timeout--) {
-        uint32_t usr = pUart->USR;
-        if ((usr & UART_USR_TFE) && !(usr & UART_USR_BUSY)) {
-            return;
-        }
+#if DMX_CFG_FRAME_DOUBLE_BUFFER
+    return g_frames[1 - g_front];
+#else
+    return g_frames[0];
+#endif
+}
+
+/**
+ * Frame buffer the TX pipeline reads (ISR context during a frame)
+ */
+static inline const uint8_t *frame_tx(void)
+{
+#if DMX_CFG_FRAME_DOUBLE_BUFFER
+    return g_frames[g_front];
+#else
+    return g_frames[0];
+#endif
+}
+
+/**
+ * Note a write into the back buffer (no-op on the single-buffer profile)
+ */
+static inline void frame_mark_dirty(void)
+{
+#if DMX_CFG_FRAME_DOUBLE_BUFFER
+    g_frame_dirty = 1;
+#endif
+}
+
+/**
+ * Non-blocking UART idle check (TX FIFO empty + shift register done)
+ *
+ * The pipeline loads the last byte into the FIFO well before the next
+ * frame deadline, so this is normally true on the first poll; if the
+ * tail is still draining, dmx_poll() just tries again next iteration.
+ */
+static uint8_t uart_is_idle(void)
+{
+    uint32_t usr = pUart->USR;
+    return (usr & UART_USR_TFE) && !(usr & UART_USR_BUSY);
+}
+
+/**
+ * Arm the sequencing timer for a one-shot interrupt in us microseconds
+ */
+static void dmx_timer_arm(uint32_t us)
+{
+    HAL_TIMER_SetCount(DMX_TIMER, (uint64_t)us * DMX_TIMER_MHZ);
+    HAL_TIMER_Start_IT(DMX_TIMER);
+}
+
+/**
+ * Stuff the TX FIFO from the frame buffer; returns 1 when the whole
+ * frame has been loaded (the FIFO tail drains on its own)
+ */
+static uint8_t dmx_fifo_stuff(void)
+{
+    while (g_tx_idx < DMX_FRAME_SIZE &&
+           (pUart->USR & UART_USR_TX_FIFO_NOT_FULL)) {
+        pUart->THR = frame_tx()[g_tx_idx++];
     }
+    return (g_tx_idx >= DMX_FRAME_SIZE) ? 1 : 0;
 }
 
 /**
- * Send DMX Break + Mark After Break
- * Uses LCR register to force TX low (break condition)
+ * Close out the current frame (last byte loaded into the FIFO)
  */
-static void send_break_mab(void)
+static void dmx_frame_done(void)
 {
-    uint32_t lcr;
+    pUart->IER = 0;
+    g_frame_count++;
+    g_dmx_state = DMX_STATE_IDLE;
+}
 
-    __disable_irq();
+/**
+ * Sequencing timer interrupt - steps BREAK -> MAB -> DATA
+ *
+ * Each phase arms the timer for the next edge and returns immediately,
+ * so IRQs stay enabled throughout the frame and RPMSG reception never
+ * waits behind frame generation. Timer IRQ entry latency (~1µs) rides
+ * on BREAK and MAB; both have tens of µs of spec margin.
+ */
+static void dmx_timer_isr(uint32_t irq, void *args)
+{
+    (void)irq;
+    (void)args;
 
-    /* Set break (force TX low) */
-    lcr = pUart->LCR;
-    pUart->LCR = lcr | UART_LCR_BREAK;
-    __DSB();
+    HAL_TIMER_ClrInt(DMX_TIMER);
+    HAL_TIMER_Stop_IT(DMX_TIMER);
 
-    /* Hold break */
-    HAL_DelayUs(g_break_us);
+    switch (g_dmx_state) {
+        case DMX_STATE_BREAK:
+            /* Break held long enough - release TX, hold the mark */
+            pUart->LCR = g_lcr_shadow;
+            __DSB();
+            g_dmx_state = DMX_STATE_MAB;
+            dmx_timer_arm(g_mab_us);
+            break;
 
-    /* Clear break (release TX) */
-    pUart->LCR = lcr;
+        case DMX_STATE_MAB:
+            /* Mark done - start the data phase */
+            g_tx_idx = 0;
+            g_dmx_state = DMX_STATE_TX_DATA;
+            if (dmx_fifo_stuff()) {
+                dmx_frame_done();   /* Frame fit the 64-byte FIFO (short universes) */
+            } else {
+                pUart->IER = UART_IER_ETBEI;
+            }
+            break;
+
+        default:
+            /* Stale interrupt after dmx_disable() - ignore */
+            break;
+    }
+}
+
+/**
+ * UART2 interrupt - refill the TX FIFO during the data phase
+ */
+static void dmx_uart_isr(uint32_t irq, void *args)
+{
+    (void)irq;
+    (void)args;
+
+    uint32_t iir = pUart->IIR & UART_IIR_ID_MASK;
+
+    /* Busy detect (LCR written while busy): read USR to clear, ignore */
+    if (iir == UART_IIR_ID_BUSY) {
+        (void)pUart->USR;
+        return;
+    }
+
+    if (g_dmx_state != DMX_STATE_TX_DATA) {
+        pUart->IER = 0;  /* Spurious THRE - mute it */
+        return;
+    }
+
+    if (dmx_fifo_stuff()) {
+        dmx_frame_done();
+    }
+}
+
+/**
+ * Kick off one frame: assert the break and hand over to the timer ISR
+ */
+static void dmx_start_frame(uint64_t now)
+{
+    g_last_frame_time = now;
+
+    g_lcr_shadow = pUart->LCR & ~UART_LCR_BREAK;
+    pUart->LCR = g_lcr_shadow | UART_LCR_BREAK;
     __DSB();
 
-    /* Mark After Break */
-    HAL_DelayUs(g_mab_us);
+    g_dmx_state = DMX_STATE_BREAK;
+    dmx_timer_arm(g_break_us);
+}
+
+/**
+ * Fold staged channels into the live frame (frame boundary only)
+ */
+static void apply_staged(void)
+{
+    if (g_stage_pending) {
+        uint8_t *frame = frame_wr();
 
-    __enable_irq();
+        for (uint16_t ch = g_stage_lo; ch <= g_stage_hi; ch++) {
+            if (g_stage_map[ch / 32] & (1u << (ch % 32))) {
+                frame[ch + 1] = g_stage_buf[ch];
+            }
+        }
+        frame_mark_dirty();
+        for (int i = 0; i < (int)(DMX_UNIVERSE_SIZE / 32); i++) {
+            g_stage_map[i] = 0;
+        }
+        g_stage_pending = 0;
+    }
+    g_commit_pending = 0;
 }
 
 /* ============================================================================
@@ -92,13 +286,25 @@ static void send_break_mab(void)
 
 void dmx_init(void)
 {
-    /* Initialize frame to 0 (start code + all channels) */
-    for (int i = 0; i < DMX_FRAME_SIZE; i++) {
-        g_dmx_frame[i] = 0;
+    /* Initialize frame buffer(s) to 0 (start code + all channels) */
+    for (int b = 0; b < (int)(sizeof(g_frames) / sizeof(g_frames[0])); b++) {
+        for (int i = 0; i < DMX_FRAME_SIZE; i++) {
+            g_frames[b][i] = 0;
+        }
     }
 
     g_frame_count = 0;
     g_enabled = 0;  /* Start disabled - user must call dmx enable */
+    g_dmx_state = DMX_STATE_IDLE;
+
+    /* Sequencing timer + UART TX interrupts (via INTMUX - must be
+     * initialized before dmx_init(), see main()) */
+    HAL_TIMER_Init(DMX_TIMER, TIMER_USER_DEFINED);
+    HAL_INTMUX_SetIRQHandler(DMX_TIMER_IRQ, dmx_timer_isr, NULL);
+    HAL_INTMUX_EnableIRQ(DMX_TIMER_IRQ);
+    HAL_INTMUX_SetIRQHandler(UART2_IRQn, dmx_uart_isr, NULL);
+    HAL_INTMUX_EnableIRQ(UART2_IRQn);
+    pUart->IER = 0;  /* THRE armed per frame by the pipeline */
 }
 
 void dmx_enable(void)
@@ -116,6 +322,16 @@ void dmx_disable(void)
         return;  /* Already disabled */
     }
     g_enabled = 0;
+
+    /* Abort a frame in flight: stop the sequencer, mute THRE, and make
+     * sure the line is not left stuck in break */
+    HAL_TIMER_Stop_IT(DMX_TIMER);
+    pUart->IER = 0;
+    if (g_dmx_state == DMX_STATE_BREAK) {
+        pUart->LCR = g_lcr_shadow;
+        __DSB();
+    }
+    g_dmx_state = DMX_STATE_IDLE;
 }
 
 uint8_t dmx_is_enabled(void)
@@ -136,9 +352,12 @@ int dmx_set_channels(uint16_t start_channel, const uint8_t *values, uint16_t cou
     }
 
     /* Frame layout: [0]=start_code, [1-512]=channels */
+    uint8_t *frame = frame_wr();
+
     for (uint16_t i = 0; i < count; i++) {
-        g_dmx_frame[start_channel + 1 + i] = values[i];
+        frame[start_channel + 1 + i] = values[i];
     }
+    frame_mark_dirty();
 
     return 0;
 }
@@ -148,15 +367,62 @@ uint8_t dmx_get_channel(uint16_t channel)
     if (channel >= DMX_UNIVERSE_SIZE) {
         return 0;
     }
-    return g_dmx_frame[channel + 1];
+    /* Read the writers' view so a set/get pair is always coherent */
+    return frame_wr()[channel + 1];
+}
+
+int dmx_stage_channels(uint16_t start_channel, const uint8_t *values, uint16_t count)
+{
+    if (start_channel >= DMX_UNIVERSE_SIZE) {
+        return -1;
+    }
+    if (start_channel + count > DMX_UNIVERSE_SIZE) {
+        return -1;
+    }
+    if (values == NULL || count == 0) {
+        return -1;
+    }
+
+    for (uint16_t i = 0; i < count; i++) {
+        uint16_t ch = start_channel + i;
+        g_stage_buf[ch] = values[i];
+        g_stage_map[ch / 32] |= 1u << (ch % 32);
+    }
+    if (!g_stage_pending || start_channel < g_stage_lo) {
+        g_stage_lo = start_channel;
+    }
+    if (!g_stage_pending || start_channel + count - 1 > g_stage_hi) {
+        g_stage_hi = start_channel + count - 1;
+    }
+    g_stage_pending = 1;
+
+    return 0;
+}
+
+int dmx_commit(void)
+{
+    /* Deferred to dmx_poll() so it lands between frames, never mid-TX.
+     * Nothing staged = harmless no-op (flag cleared at the boundary). */
+    g_commit_pending = 1;
+    return 0;
 }
 
 void dmx_blackout(void)
 {
     /* Keep start code at 0, set all channels to 0 */
+    uint8_t *frame = frame_wr();
+
     for (int i = 1; i < DMX_FRAME_SIZE; i++) {
-        g_dmx_frame[i] = 0;
+        frame[i] = 0;
     }
+    frame_mark_dirty();
+
+    /* Discard staged-but-uncommitted data */
+    for (int i = 0; i < (int)(DMX_UNIVERSE_SIZE / 32); i++) {
+        g_stage_map[i] = 0;
+    }
+    g_stage_pending = 0;
+    g_commit_pending = 0;
 }
 
 int dmx_set_timing(uint16_t refresh_hz, uint16_t break_us, uint16_t mab_us)
@@ -211,39 +477,35 @@ uint32_t dmx_get_frame_interval_us(void)
 
 void dmx_poll(uint64_t now)
 {
-    if (!g_enabled) {
-        return;
+    if (!g_enabled || g_dmx_state != DMX_STATE_IDLE) {
+        return;  /* Frame in flight - the ISRs are driving it */
     }
 
-    switch (g_dmx_state) {
-        case DMX_STATE_IDLE:
-            if (now - g_last_frame_time >= dmx_get_frame_interval_us()) {
-                /* Wait for previous TX to complete */
-                uart_wait_idle();
-                /* Atomic break + MAB (~162µs) */
-                send_break_mab();
-                g_tx_idx = 0;
-                g_dmx_state = DMX_STATE_TX_DATA;
-                /* FALL THROUGH - start TX immediately */
-            } else {
-                break;
-            }
-            /* fall through */
+    /* Frame boundary: fold in a committed cue before the next BREAK so
+     * it appears whole in exactly one frame */
+    if (g_commit_pending) {
+        apply_staged();
+    }
 
-        case DMX_STATE_TX_DATA:
-            /* Stuff FIFO while there's room (64-byte FIFO) */
-            while (g_tx_idx < DMX_FRAME_SIZE &&
-                   (pUart->USR & UART_USR_TX_FIFO_NOT_FULL)) {
-                pUart->THR = g_dmx_frame[g_tx_idx++];
-            }
-            /* Frame complete? */
-            if (g_tx_idx >= DMX_FRAME_SIZE) {
-                g_frame_count++;
-                g_last_frame_time = now;
-                g_dmx_state = DMX_STATE_IDLE;
-            }
-            break;
+    if (now - g_last_frame_time < dmx_get_frame_interval_us()) {
+        return;  /* Not due yet */
+    }
+    if (!uart_is_idle()) {
+        return;  /* FIFO tail still draining - retry next iteration */
     }
+
+#if DMX_CFG_FRAME_DOUBLE_BUFFER
+    /* Atomic flip: the pipeline is idle, so nothing is reading the
+     * front buffer. Publish the back buffer and re-sync the new back
+     * so writers keep a complete frame to build on. */
+    if (g_frame_dirty) {
+        g_front = 1 - g_front;
+        memcpy(g_frames[1 - g_front], g_frames[g_front], DMX_FRAME_SIZE);
+        g_frame_dirty = 0;
+    }
+#endif
+
+    dmx_start_frame(now);
 }
 
 uint8_t dmx_is_busy(void)
@@ -44,7 +44,8 @@ typedef struct {
 
 /**
  * Initialize DMX driver
- * Must be called after UART2 is initialized
+ * Must be called after UART2 and the INTMUX are initialized - installs
+ * the TIMER4 sequencing interrupt and the UART2 TX interrupt.
  */
 void dmx_init(void);
 
@@ -79,8 +80,27 @@ int dmx_set_channels(uint16_t start_channel, const uint8_t *values, uint16_t cou
  */
 uint8_t dmx_get_channel(uint16_t channel);
 
+/**
+ * Stage channel values into the pending buffer
+ * Staged values do not touch the live frame until dmx_commit().
+ * @param start_channel First channel (0-511)
+ * @param values Array of values
+ * @param count Number of channels to stage
+ * @return 0 on success, -1 on error
+ */
+int dmx_stage_channels(uint16_t start_channel, const uint8_t *values, uint16_t count);
+
+/**
+ * Commit staged channels at the next frame boundary
+ * dmx_poll() folds them into the live frame just before the next
+ * BREAK, so a multi-channel cue never tears mid-frame.
+ * @return 0 (a commit with nothing staged is a no-op)
+ */
+int dmx_commit(void);
+
 /**
  * Set all channels to 0 (blackout)
+ * Also discards staged-but-uncommitted data.
  */
 void dmx_blackout(void);
 
@@ -109,11 +129,11 @@ void dmx_get_status(dmx_driver_status_t *status);
 uint32_t dmx_get_frame_interval_us(void);
 
 /**
- * Poll DMX TX state machine (non-blocking)
- * Call from main loop. Handles:
- *   - Frame timing check
- *   - Break+MAB (atomic, ~162µs with IRQ disabled)
- *   - FIFO stuffing (non-blocking, fills 64-byte FIFO)
+ * Poll DMX pacing (non-blocking)
+ * Call from main loop. Only checks the frame deadline and kicks a
+ * frame off; BREAK/MAB/DATA are then sequenced entirely by the TIMER4
+ * and UART2 interrupts, so the loop (and RPMSG handling) never waits
+ * on the wire.
  *
  * @param now Current time in microseconds
  */
@@ -0,0 +1,61 @@
+/*
+ * MCU Memory Budget Profiles
+ *
+ * Copyright Pierre Jay (c) 2025
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Description:
+ *   Compile-time memory profiles for the 32KB-SRAM Cortex-M0+. All
+ *   SRAM-resident buffer sizes are gathered here so the budget is
+ *   visible in one place and selectable from gcc/Makefile:
+ *
+ *     make DMX_MEM_PROFILE=COMPACT   (default)
+ *     make DMX_MEM_PROFILE=STOCK
+ *
+ *   COMPACT right-sizes the parser buffers for the DMX workload (the
+ *   largest real command is a 519-byte full-universe SET_CHANNELS) and
+ *   spends the headroom on a second frame buffer with an atomic flip,
+ *   so channel writes never race the TX pipeline mid-frame.
+ *
+ *   STOCK keeps the historical single-buffer allocation as a fallback
+ *   if SRAM pressure ever forces the double buffer out again.
+ *
+ *   NOTE: the rpmsg-lite vrings are NOT governed here. They live in
+ *   shared DDR (RPMSG_MEM_BASE), so shrinking them frees no SRAM, and
+ *   their geometry (RL_BUFFER_COUNT x RL_BUFFER_PAYLOAD_SIZE) must
+ *   mirror the Linux-side virtio rpmsg layout - see
+ *   platform/rpmsg_config.h.
+ */
+
+#ifndef DMX_MEM_PROFILE_H
+#define DMX_MEM_PROFILE_H
+
+/* Default to COMPACT when the Makefile passes nothing */
+#if !defined(DMX_MEM_PROFILE_COMPACT) && !defined(DMX_MEM_PROFILE_STOCK)
+#define DMX_MEM_PROFILE_COMPACT
+#endif
+
+#ifdef DMX_MEM_PROFILE_COMPACT
+
+/* Parser buffer: 4-byte header + 539-byte payload + checksum. Covers
+ * the 514-byte SET_CHANNELS payload with margin, 56 bytes under STOCK. */
+#define DMX_CFG_CMD_BUF_SIZE        544
+
+/* RPMSG RX ring (power of two). Must absorb at least one 496-byte
+ * rpmsg packet between main-loop drains; 1KB covers a full command
+ * arriving split across two packets. */
+#define DMX_CFG_RX_RING_SIZE        1024
+
+/* Double-buffered DMX frame (2 x 513 bytes): writers fill the back
+ * buffer, the TX pipeline reads the front, flip at frame start. */
+#define DMX_CFG_FRAME_DOUBLE_BUFFER 1
+
+#else /* DMX_MEM_PROFILE_STOCK */
+
+#define DMX_CFG_CMD_BUF_SIZE        600
+#define DMX_CFG_RX_RING_SIZE        1024
+#define DMX_CFG_FRAME_DOUBLE_BUFFER 0
+
+#endif
+
+#endif /* DMX_MEM_PROFILE_H */
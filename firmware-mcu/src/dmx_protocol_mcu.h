@@ -34,11 +34,37 @@ typedef enum {
     CMD_DMX_BLACKOUT        = 0x05,  /* Set all channels to 0 */
     CMD_DMX_SET_TIMING      = 0x06,  /* Set FPS/BREAK/MAB timing (Hz/µs) */
     CMD_DMX_GET_TIMING      = 0x07,  /* Get current timing config */
+    CMD_DMX_BATCH           = 0x08,  /* N sub-commands in one round trip (AP only) */
+    CMD_DMX_SET_SPARSE      = 0x09,  /* Set N non-contiguous channels (AP only) */
+    CMD_DMX_FADE            = 0x0A,  /* Fade a channel range (AP only) */
+    CMD_DMX_STAGE           = 0x0B,  /* Stage channels into the pending buffer */
+    CMD_DMX_COMMIT          = 0x0C,  /* Apply staged channels at the next frame */
+    CMD_DMX_GET_STATS       = 0x0D,  /* Frame timing stats (AP only) */
+    CMD_DMX_CAPTURE         = 0x0E,  /* Wire-level RX capture (AP only) */
+    CMD_DMX_SCENE_STORE     = 0x0F,  /* Store output into scene slot (AP only) */
+    CMD_DMX_SCENE_RECALL    = 0x10,  /* Recall scene slot (AP only) */
+    CMD_DMX_GET_UNIVERSE    = 0x11,  /* Channel/config readback (AP only) */
+    CMD_DMX_SUBSCRIBE       = 0x12,  /* Pushed status events (AP only) */
 
     /* System commands (MCU only - require magic validation) */
     CMD_SYSTEM_RESET        = 0xFF,  /* Graceful MCU reset (requires SYSTEM_RESET_MAGIC) */
 } dmx_cmd_type_t;
 
+/*
+ * Command flags (high bits of the cmd byte)
+ *
+ * DMX_CMD_FLAG_NO_ACK suppresses the response packet for write-type
+ * commands (SET_CHANNELS, ENABLE, DISABLE, BLACKOUT, SET_TIMING). At
+ * streaming rates the per-command ack doubles RPMSG traffic and blocks
+ * the sender for data it never uses; errors are counted in the firmware
+ * error counter instead and surface through the status/stats path.
+ *
+ * NOTE: CMD_SYSTEM_RESET (0xFF) predates the flag bit and is matched on
+ * the full byte - the parser checks it before stripping flags.
+ */
+#define DMX_CMD_FLAG_NO_ACK  0x80    /* Fire-and-forget: no response sent */
+#define DMX_CMD_TYPE_MASK    0x7F    /* Command type without flag bits */
+
 /* ============================================================================
  * System Command Security (MCU only)
  * ============================================================================ */
@@ -64,6 +90,7 @@ typedef enum {
     STATUS_INVALID_CHECKSUM = 0x02,  /* Checksum mismatch */
     STATUS_INVALID_CMD      = 0x03,  /* Unknown command */
     STATUS_INVALID_LENGTH   = 0x04,  /* Invalid payload length */
+    STATUS_INVALID_UNIVERSE = 0x05,  /* Universe out of range (AP only - MCU has one output) */
 } dmx_status_t;
 
 /* ============================================================================
@@ -131,12 +158,16 @@ typedef struct {
  * Returns current DMX status
  *
  * Layout:
- *   [enabled:1] [frame_count:4] [fps:4]
+ *   [enabled:1] [frame_count:4] [fps:4] [effective_hz:2] [throttled:1] [rsvd:1]
  */
 typedef struct {
     uint8_t enabled;        /* 0=disabled, 1=enabled */
     uint32_t frame_count;   /* Total frames sent (little-endian) */
     uint32_t fps;           /* Frames per second × 100 (e.g., 4400 = 44.00 Hz) */
+    uint16_t effective_hz;  /* Rate currently paced (= refresh rate here -
+                             * adaptive keep-alive throttling is AP only) */
+    uint8_t throttled;      /* Always 0 (AP only) */
+    uint8_t rsvd;           /* Alignment/reserved */
 } __attribute__((packed)) dmx_status_payload_t;
 
 /*
@@ -13,6 +13,8 @@
  *   Protocol 100% compatible with CPU2 (RT-Thread) implementation.
  */
 
+#include <string.h>
+
 #include "hal_bsp.h"
 #include "hal_base.h"
 
@@ -21,6 +23,7 @@
 
 #include "dmx_protocol_mcu.h"
 #include "dmx_driver.h"
+#include "dmx_mem_profile.h"
 
 /* ============================================================================
  * Configuration
@@ -32,9 +35,11 @@
 #define REMOTE_ID            4U
 #define RPMSG_MEM_BASE       0x03c20000U
 
-/* Buffers */
-#define RX_BUF_SIZE          64    /* RPMSG RX ring buffer */
-#define CMD_BUF_SIZE         600   /* Protocol parser buffer */
+/* Buffers - sized by the memory budget profile (dmx_mem_profile.h,
+ * selected via DMX_MEM_PROFILE in gcc/Makefile) */
+#define RX_RING_SIZE         DMX_CFG_RX_RING_SIZE   /* Power of two */
+#define RX_RING_MASK         (RX_RING_SIZE - 1)
+#define CMD_BUF_SIZE         DMX_CFG_CMD_BUF_SIZE   /* Protocol parser buffer */
 
 /* Timing */
 #define TIMER_FREQ_MHZ       24    /* PLL_INPUT_OSC_RATE = 24MHz */
@@ -48,23 +53,17 @@
 static struct rpmsg_lite_instance *g_rpmsg_instance = NULL;
 static struct rpmsg_lite_endpoint *g_rpmsg_ept = NULL;
 
-/* RPMSG RX ring buffer */
-static volatile uint8_t g_rx_buf[RX_BUF_SIZE];
-static volatile uint32_t g_rx_head = 0;
-static volatile uint32_t g_rx_tail = 0;
+/* RPMSG RX ring - lock-free SPSC. The RPMSG callback (IRQ context) is
+ * the only producer, the main loop the only consumer; head and tail are
+ * free-running 32-bit counters masked on access, so neither side ever
+ * touches the other's index and no IRQ masking is needed. */
+static volatile uint8_t g_rx_ring[RX_RING_SIZE];
+static volatile uint32_t g_rx_head = 0;     /* Producer-owned */
+static volatile uint32_t g_rx_tail = 0;     /* Consumer-owned */
+static volatile uint32_t g_rx_dropped = 0;  /* Bytes discarded (ring full) */
 static volatile uint32_t g_rx_src = 0;
 
-/* Protocol parser */
-typedef enum {
-    PARSE_IDLE,
-    PARSE_CMD,
-    PARSE_LEN_LO,
-    PARSE_LEN_HI,
-    PARSE_DATA,
-    PARSE_CHECKSUM
-} parse_state_t;
-
-static parse_state_t g_parse_state = PARSE_IDLE;
+/* Protocol parser (span-wise - see process_rx_ring()) */
 static uint8_t g_cmd_buf[CMD_BUF_SIZE];
 static uint16_t g_cmd_idx = 0;
 static uint16_t g_cmd_payload_len = 0;
@@ -73,6 +72,10 @@ static uint16_t g_cmd_payload_len = 0;
 static volatile uint32_t g_rx_count = 0;
 static volatile uint32_t g_tx_count = 0;
 static volatile uint32_t g_cmd_count = 0;
+static volatile uint32_t g_err_count = 0;
+
+/* Set while dispatching a NO_ACK command - send_response() drops the ack */
+static uint8_t g_no_ack = 0;
 
 /* Timing - using HAL_GetSysTimerCount() @ 24MHz */
 static inline uint64_t get_time_us(void)
@@ -111,6 +114,14 @@ static void send_response(uint8_t status, const uint8_t *payload, uint16_t paylo
     uint8_t resp[32];
     uint16_t total_len;
 
+    /* Fire-and-forget command: no ack, but failures still count */
+    if (g_no_ack) {
+        if (status != STATUS_OK) {
+            g_err_count++;
+        }
+        return;
+    }
+
     if (g_rx_src == 0) {
         return;
     }
@@ -162,6 +173,34 @@ static void handle_cmd_set_channels(const uint8_t *data, uint16_t len)
     send_response(STATUS_OK, NULL, 0);
 }
 
+static void handle_cmd_stage(const uint8_t *data, uint16_t len)
+{
+    if (len < 3) {
+        printf("[CMD] STAGE: too short\n");
+        send_response(STATUS_INVALID_LENGTH, NULL, 0);
+        return;
+    }
+
+    uint16_t start = data[0] | (data[1] << 8);
+    uint16_t count = len - 2;
+
+    if (dmx_stage_channels(start, &data[2], count) < 0) {
+        printf("[CMD] STAGE: error (start=%d, count=%d)\n", start, count);
+        send_response(STATUS_ERROR, NULL, 0);
+        return;
+    }
+
+    printf("[CMD] STAGE: start=%d, count=%d\n", start, count);
+    send_response(STATUS_OK, NULL, 0);
+}
+
+static void handle_cmd_commit(void)
+{
+    dmx_commit();
+    printf("[CMD] COMMIT\n");
+    send_response(STATUS_OK, NULL, 0);
+}
+
 static void handle_cmd_get_status(void)
 {
     dmx_driver_status_t st;
@@ -171,6 +210,9 @@ static void handle_cmd_get_status(void)
     payload.enabled = st.enabled;
     payload.frame_count = st.frame_count;
     payload.fps = st.refresh_hz * 100;
+    payload.effective_hz = st.refresh_hz;  /* No adaptive mode on the MCU */
+    payload.throttled = 0;
+    payload.rsvd = 0;
 
     printf("[CMD] GET_STATUS: en=%d, frames=%lu\n",
            st.enabled, (unsigned long)st.frame_count);
@@ -318,6 +360,13 @@ static void handle_complete_packet(void)
     uint16_t payload_len = buf[2] | (buf[3] << 8);
     uint8_t *payload = (payload_len > 0) ? &buf[4] : NULL;
 
+    /* CMD_SYSTEM_RESET (0xFF) predates the flag bit - match it on the
+     * full byte before stripping DMX_CMD_FLAG_NO_ACK */
+    if (cmd != CMD_SYSTEM_RESET) {
+        g_no_ack = (cmd & DMX_CMD_FLAG_NO_ACK) ? 1 : 0;
+        cmd &= DMX_CMD_TYPE_MASK;
+    }
+
     switch (cmd) {
         case CMD_DMX_SET_CHANNELS:
             handle_cmd_set_channels(payload, payload_len);
@@ -340,6 +389,12 @@ static void handle_complete_packet(void)
         case CMD_DMX_GET_TIMING:
             handle_cmd_get_timing();
             break;
+        case CMD_DMX_STAGE:
+            handle_cmd_stage(payload, payload_len);
+            break;
+        case CMD_DMX_COMMIT:
+            handle_cmd_commit();
+            break;
         case CMD_SYSTEM_RESET:
             handle_cmd_system_reset(payload, payload_len);
             break;
@@ -348,56 +403,97 @@ static void handle_complete_packet(void)
             send_response(STATUS_INVALID_CMD, NULL, 0);
             break;
     }
+
+    g_no_ack = 0;
 }
 
-static void parse_rx_byte(uint8_t byte)
+/**
+ * Bulk dequeue up to n bytes from the RX ring into dst
+ * Consumer side of the SPSC ring - at most two memcpys (wrap).
+ * @return Number of bytes actually copied
+ */
+static uint32_t rx_ring_read(uint8_t *dst, uint32_t n)
 {
-    switch (g_parse_state) {
-        case PARSE_IDLE:
-            if (byte == DMX_MAGIC_CMD) {
-                g_cmd_buf[0] = byte;
-                g_cmd_idx = 1;
-                g_parse_state = PARSE_CMD;
-            }
-            break;
+    uint32_t tail = g_rx_tail;
+    uint32_t avail = g_rx_head - tail;
 
-        case PARSE_CMD:
-            g_cmd_buf[g_cmd_idx++] = byte;
-            g_parse_state = PARSE_LEN_LO;
-            break;
+    if (n > avail) {
+        n = avail;
+    }
+    if (n == 0) {
+        return 0;
+    }
 
-        case PARSE_LEN_LO:
-            g_cmd_buf[g_cmd_idx++] = byte;
-            g_cmd_payload_len = byte;
-            g_parse_state = PARSE_LEN_HI;
-            break;
+    uint32_t off = tail & RX_RING_MASK;
+    uint32_t first = RX_RING_SIZE - off;
+    if (first > n) {
+        first = n;
+    }
+    memcpy(dst, (const uint8_t *)&g_rx_ring[off], first);
+    if (n > first) {
+        memcpy(dst + first, (const uint8_t *)g_rx_ring, n - first);
+    }
 
-        case PARSE_LEN_HI:
-            g_cmd_buf[g_cmd_idx++] = byte;
-            g_cmd_payload_len |= (byte << 8);
+    /* Data must be out of the ring before the producer may reuse it */
+    __DSB();
+    g_rx_tail = tail + n;
+    return n;
+}
 
-            if (g_cmd_payload_len > CMD_BUF_SIZE - 5) {
-                printf("[PARSE] Payload too large: %d\n", g_cmd_payload_len);
-                g_parse_state = PARSE_IDLE;
-            } else if (g_cmd_payload_len == 0) {
-                g_parse_state = PARSE_CHECKSUM;
-            } else {
-                g_parse_state = PARSE_DATA;
+/**
+ * Drain the RX ring span-wise into the command buffer
+ *
+ * Instead of one state transition per byte, the parser computes how
+ * many bytes the packet in progress still needs (4-byte header first,
+ * then payload + checksum) and pulls them in bulk - a full 519-byte
+ * SET_CHANNELS costs three memcpys instead of 519 switch dispatches.
+ * Only the magic hunt goes byte-at-a-time, and in the normal case the
+ * magic is the very first byte.
+ */
+static void process_rx_ring(void)
+{
+    for (;;) {
+        if (g_cmd_idx == 0) {
+            /* Hunt for the magic byte */
+            uint8_t b;
+            for (;;) {
+                if (rx_ring_read(&b, 1) == 0) {
+                    return;
+                }
+                if (b == DMX_MAGIC_CMD) {
+                    g_cmd_buf[0] = b;
+                    g_cmd_idx = 1;
+                    break;
+                }
             }
-            break;
+        }
+
+        /* How much does this packet still need? Header first, then
+         * payload + checksum once the length field is in. */
+        uint32_t need;
+        if (g_cmd_idx < 4) {
+            need = 4 - g_cmd_idx;
+        } else {
+            need = (uint32_t)(4 + g_cmd_payload_len + 1) - g_cmd_idx;
+        }
 
-        case PARSE_DATA:
-            g_cmd_buf[g_cmd_idx++] = byte;
-            if (g_cmd_idx >= 4 + g_cmd_payload_len) {
-                g_parse_state = PARSE_CHECKSUM;
+        uint32_t got = rx_ring_read(&g_cmd_buf[g_cmd_idx], need);
+        g_cmd_idx += got;
+        if (got < need) {
+            return;  /* Rest of the packet arrives later */
+        }
+
+        if (g_cmd_idx == 4) {
+            g_cmd_payload_len = g_cmd_buf[2] | (g_cmd_buf[3] << 8);
+            if (g_cmd_payload_len > CMD_BUF_SIZE - 5) {
+                printf("[PARSE] Payload too large: %d\n", g_cmd_payload_len);
+                g_cmd_idx = 0;  /* Resync on the next magic */
             }
-            break;
+            continue;
+        }
 
-        case PARSE_CHECKSUM:
-            g_cmd_buf[g_cmd_idx++] = byte;
-            handle_complete_packet();
-            g_parse_state = PARSE_IDLE;
-            break;
+        handle_complete_packet();
+        g_cmd_idx = 0;
     }
 }
 
@@ -412,14 +508,32 @@ static int32_t rpmsg_rx_callback(void *payload, uint32_t payload_len,
 
     g_rx_src = src;
 
-    for (uint32_t i = 0; i < payload_len; i++) {
-        uint32_t next = (g_rx_head + 1) % RX_BUF_SIZE;
-        if (next != g_rx_tail) {
-            g_rx_buf[g_rx_head] = ((uint8_t*)payload)[i];
-            g_rx_head = next;
-            g_rx_count++;
-        }
+    /* Bulk enqueue - producer side of the SPSC ring, at most two
+     * memcpys. A packet that doesn't fit is dropped whole so the
+     * parser never sees a truncated command. */
+    uint32_t head = g_rx_head;
+    uint32_t free = RX_RING_SIZE - (head - g_rx_tail);
+
+    if (payload_len > free) {
+        g_rx_dropped += payload_len;
+        return RL_RELEASE;
+    }
+
+    uint32_t off = head & RX_RING_MASK;
+    uint32_t first = RX_RING_SIZE - off;
+    if (first > payload_len) {
+        first = payload_len;
+    }
+    memcpy((uint8_t *)&g_rx_ring[off], payload, first);
+    if (payload_len > first) {
+        memcpy((uint8_t *)g_rx_ring, (const uint8_t *)payload + first,
+               payload_len - first);
     }
+
+    /* Data must land before the consumer sees the new head */
+    __DSB();
+    g_rx_head = head + payload_len;
+    g_rx_count += payload_len;
     return RL_RELEASE;
 }
 
@@ -518,27 +632,21 @@ int main(void)
     while (1) {
         uint64_t now = get_time_us();
 
-        /* 1. Process pending RPMSG bytes */
-        while (g_rx_head != g_rx_tail) {
-            uint8_t c;
-
-            __disable_irq();
-            c = g_rx_buf[g_rx_tail];
-            g_rx_tail = (g_rx_tail + 1) % RX_BUF_SIZE;
-            __enable_irq();
-
-            parse_rx_byte(c);
-        }
+        /* 1. Process pending RPMSG bytes (span-wise, no IRQ masking -
+         * the SPSC ring indices keep producer and consumer apart) */
+        process_rx_ring();
 
-        /* 2. Poll DMX TX state machine (non-blocking) */
+        /* 2. Poll DMX frame pacing (frames are interrupt-driven) */
         dmx_poll(now);
 
         /* 3. Heartbeat every 5 seconds */
         if (now - last_heartbeat_time >= HEARTBEAT_INTERVAL) {
-            printf("[HB] rx=%lu tx=%lu cmd=%lu dmx=%lu\n",
+            printf("[HB] rx=%lu tx=%lu cmd=%lu err=%lu drop=%lu dmx=%lu\n",
                    (unsigned long)g_rx_count,
                    (unsigned long)g_tx_count,
                    (unsigned long)g_cmd_count,
+                   (unsigned long)g_err_count,
+                   (unsigned long)g_rx_dropped,
                    (unsigned long)dmx_get_frame_count());
             last_heartbeat_time = now;
         }